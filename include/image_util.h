@@ -159,11 +159,37 @@ int image_util_transform_set_hardware_acceleration(transformation_h handle, bool
 */
 int image_util_transform_set_colorspace(transformation_h handle, image_util_colorspace_e colorspace);
 
+/**
+* @brief Sets whether the converting to #IMAGE_UTIL_COLORSPACE_RGB565 uses the ordered dither.
+* @details The dither spreads the error of dropping the low bits of each channel over a 4x4 pattern, \n
+*          which hides the banding of the gradients on the 16 bits displays.
+* @since_tizen 5.5
+*
+* @remarks The default is @c false, the low bits are truncated. \n
+*          The colors which #IMAGE_UTIL_COLORSPACE_RGB565 can represent are not changed by the dither. \n
+*          It has no effect on the other colorspaces.
+*
+* @param[in] handle The handle to image util transform
+* @param[in] dither @c true to dither, otherwise @c false
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+*
+* @pre image_util_transform_create().
+*
+* @see image_util_transform_set_colorspace()
+* @see image_util_transform_run()
+*/
+int image_util_transform_set_dither(transformation_h handle, bool dither);
+
 /**
 * @brief Sets the information of the resizing.
 * @since_tizen @if MOBILE 2.3 @elseif WEARABLE 2.3.1 @endif
 *
-* @remarks image_util_transform_set_resolution and image_util_transform_set_crop_area can't do that at the same time.
+* @remarks If the crop area is also set, the cropped image is resized to @a width x @a height.
 *
 * @param[in] handle The handle to image util transform
 * @param[in] width The width of image buffer
@@ -184,6 +210,58 @@ int image_util_transform_set_colorspace(transformation_h handle, image_util_colo
 */
 int image_util_transform_set_resolution(transformation_h handle, unsigned int width, unsigned int height);
 
+/**
+* @brief Sets the filter of the resizing.
+* @since_tizen 5.5
+*
+* @remarks The default filter is #IMAGE_UTIL_RESIZE_FILTER_BILINEAR. \n
+*          #IMAGE_UTIL_RESIZE_FILTER_NEAREST and #IMAGE_UTIL_RESIZE_FILTER_BILINEAR are for the previews which need the low latency, \n
+*          and #IMAGE_UTIL_RESIZE_FILTER_BOX is for the thumbnails. \n
+*          If the image is reduced to less than the half, it is halved by averaging 2x2 pixels until it is within 2 times of the resolution, \n
+*          and then the filter is applied, except #IMAGE_UTIL_RESIZE_FILTER_NEAREST. \n
+*          It has no effect if the image is not resized.
+*
+* @param[in] handle The handle to image util transform
+* @param[in] filter The filter of the resizing
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+*
+* @pre image_util_transform_create().
+*
+* @see image_util_transform_set_resolution()
+* @see image_util_transform_run()
+*/
+int image_util_transform_set_resize_filter(transformation_h handle, image_util_resize_filter_e filter);
+
+/**
+* @brief Sets the maximum number of the threads which a transformation runs on.
+* @details The large conversions, resizings and rotatings are split into the bands of the rows, \n
+*          which are rendered at the same time on the thread pool of the process and the calling thread.
+* @since_tizen 5.5
+*
+* @remarks The default is @c 0, the threads are up to the number of the processors. \n
+*          @c 1 runs the transformation only on the calling thread, for the application which runs the transformations in parallel by itself. \n
+*          The small images are not split. The result is the same regardless of the number of the threads.
+*
+* @param[in] handle The handle to image util transform
+* @param[in] max_threads The maximum number of the threads, @c 0 for the number of the processors
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+*
+* @pre image_util_transform_create().
+*
+* @see image_util_transform_run()
+*/
+int image_util_transform_set_max_threads(transformation_h handle, unsigned int max_threads);
+
 /**
 * @brief Sets the information of the rotating.
 * @since_tizen @if MOBILE 2.3 @elseif WEARABLE 2.3.1 @endif
@@ -210,7 +288,9 @@ int image_util_transform_set_rotation(transformation_h handle, image_util_rotati
 * @brief Sets the information of the cropping.
 * @since_tizen @if MOBILE 2.3 @elseif WEARABLE 2.3.1 @endif
 *
-* @remarks image_util_transform_set_resolution and image_util_transform_set_crop_area can't do that at the same time.
+* @remarks If the resolution is also set, the cropped image is resized to the resolution. \n
+*          The pixels out of the crop area are not used for the resizing, \n
+*          image_util_transform_run_roi() is for the tiles of a region which are joined without seams.
 *
 * @param[in] handle The handle to image util transform
 * @param[in] start_x The start x position of cropped image buffer
@@ -233,6 +313,143 @@ int image_util_transform_set_rotation(transformation_h handle, image_util_rotati
 */
 int image_util_transform_set_crop_area(transformation_h handle, unsigned int start_x, unsigned int start_y, unsigned int end_x, unsigned int end_y);
 
+/**
+* @brief Prepares the transformation for the source images of the format and the resolution.
+* @details The filters and the converters of the transformation are made once for the source, \n
+*          and the source images of the same format and resolution, like the frames of a camera preview, are transformed without making them again.
+* @since_tizen 5.5
+*
+* @remarks The preparation is dropped when the colorspace, the resolution, the rotation or the crop area is set after this function. \n
+*          The source images of the other format or resolution are transformed as before.
+*
+* @param[in] handle The handle to image util transform
+* @param[in] colorspace The colorspace of the source images
+* @param[in] width The width of the source images
+* @param[in] height The height of the source images
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT Not supported format
+* @retval #IMAGE_UTIL_ERROR_OUT_OF_MEMORY Out of memory
+*
+* @pre image_util_transform_create().
+* @pre image_util_transform_set_colorspace(), image_util_transform_set_resolution(), image_util_transform_set_rotation() and image_util_transform_set_crop_area() as needed.
+*
+* @see image_util_transform_run()
+* @see image_util_transform_run_sync()
+*/
+int image_util_transform_prepare(transformation_h handle, image_util_colorspace_e colorspace, unsigned int width, unsigned int height);
+
+/**
+* @brief Sets the maximum number of the transformations in flight.
+* @details image_util_transform_run() and image_util_transform_run_to() put the transformation into the queue of the handle, \n
+*          and the transformations are done one by one in the order of the submission. \n
+*          If the queue already has @a depth transformations including the running one, the submission fails.
+* @since_tizen 5.5
+*
+* @remarks The default depth is 4.
+*
+* @param[in] handle The handle to image util transform
+* @param[in] depth The maximum number of the queued transformations
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+*
+* @pre image_util_transform_create().
+*
+* @see image_util_transform_create()
+* @see image_util_transform_run()
+* @see image_util_transform_destroy()
+*/
+int image_util_transform_set_queue_depth(transformation_h handle, unsigned int depth);
+
+/**
+* @brief Sets the number of the result packets which are kept for reuse.
+* @details If @a size is not 0, the result packets of the transformation are recycled. \n
+*          When a result packet is destroyed with media_packet_destroy(), its buffer returns to the pool of the handle \n
+*          instead of being freed, and it is given again as the result of a later transformation which has the same format and resolution.
+* @since_tizen 5.5
+*
+* @remarks The pool is disabled by default. \n
+*          The recycled packet keeps the properties set by the application like the pts, so set them again if needed. \n
+*          The packets which are still in use when the handle is destroyed are freed normally by media_packet_destroy().
+*
+* @param[in] handle The handle to image util transform
+* @param[in] size The maximum number of the packets in the pool, 0 disables the pool
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_OUT_OF_MEMORY Out of memory
+*
+* @pre image_util_transform_create().
+*
+* @see image_util_transform_create()
+* @see image_util_transform_run()
+* @see image_util_transform_destroy()
+*/
+int image_util_transform_set_packet_pool_size(transformation_h handle, unsigned int size);
+
+/**
+* @brief Sets the priority of the transformations of the handle.
+* @details The asynchronous transformations, decodings and encodings of all the handles share the worker threads. \n
+*          The waiting work of the higher priority is started first, and the works of the same priority are started in the order of submission.
+* @since_tizen 5.5
+*
+* @remarks The default priority is #IMAGE_UTIL_PRIORITY_NORMAL. \n
+*          The transformations of a handle are still completed in the order of submission. \n
+*          A running transformation is not preempted.
+*
+* @param[in] handle The handle to image util transform
+* @param[in] priority The priority of the transformations
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+*
+* @pre image_util_transform_create().
+*
+* @see image_util_transform_run()
+* @see image_util_decode_set_priority()
+* @see image_util_encode_set_priority()
+*/
+int image_util_transform_set_priority(transformation_h handle, image_util_priority_e priority);
+
+/**
+* @brief Sets the deadline of the transformations which are submitted after this function.
+* @details The transformation which is not finished in @a timeout milliseconds after its submission \n
+*          is dropped or stops at the next row or tile, and its callback is called with #IMAGE_UTIL_ERROR_TIMED_OUT.
+* @since_tizen 5.5
+*
+* @remarks There is no deadline by default. \n
+*          image_util_transform_run_sync() doesn't have the deadline.
+*
+* @param[in] handle The handle to image util transform
+* @param[in] timeout The deadline in milliseconds after the submission, 0 for no deadline
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+*
+* @pre image_util_transform_create().
+*
+* @see image_util_transform_run()
+* @see image_util_transform_cancel()
+*/
+int image_util_transform_set_deadline(transformation_h handle, unsigned int timeout);
+
 /**
 * @brief Gets the colorspace of the image buffer.
 * @since_tizen @if MOBILE 2.3 @elseif WEARABLE 2.3.1 @endif
@@ -332,7 +549,9 @@ int image_util_transform_get_crop_area(transformation_h handle, unsigned int *st
 *          If you set more than two transforming, the order of running is crop or resolution, colorspace converting, rotation. \n
 * @since_tizen @if MOBILE 2.3 @elseif WEARABLE 2.3.1 @endif
 *
-* @remarks If H/W acceleration is not set, transformation is done via S/W acceleration.
+* @remarks If H/W acceleration is not set, transformation is done via S/W acceleration. \n
+*          The transformations of a handle are queued and the callbacks are called in the order of the submission. \n
+*          The settings of the handle are read when the queued transformation starts.
 *
 * @param[in] handle The handle of transform
 * @param[in] src The handle to image util transform
@@ -344,13 +563,330 @@ int image_util_transform_get_crop_area(transformation_h handle, unsigned int *st
 *
 * @retval #IMAGE_UTIL_ERROR_NONE Successful
 * @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
-* @retval #IMAGE_UTIL_ERROR_INVALID_OPERATION Invalid operation
+* @retval #IMAGE_UTIL_ERROR_INVALID_OPERATION Invalid operation or the queue is full
 *
+* @see image_util_transform_set_queue_depth()
 * @see image_util_transform_create()
 * @see image_util_transform_destroy()
 */
 int image_util_transform_run(transformation_h handle, media_packet_h src, image_util_transform_completed_cb callback, void *user_data);
 
+/**
+* @brief Transforms the image into the media packet given by the caller.
+* @details The function works like image_util_transform_run(), except that the result is written into @a dst \n
+*          instead of a newly allocated media packet. \n
+* @since_tizen 5.5
+*
+* @remarks The format and the resolution of @a dst must be the same as the result of the transformation, \n
+*          and the buffer of @a dst must be large enough to hold the result. \n
+*          The @a dst passed to the callback is the @a dst given by the caller, so it should not be released in the callback.
+*
+* @param[in] handle The handle of transform
+* @param[in] src The source media packet
+* @param[in] dst The destination media packet, which is allocated by the caller
+* @param[in] callback The callback function to be invoked
+* @param[in] user_data The user data to be passed to the callback function
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_INVALID_OPERATION Invalid operation
+*
+* @see image_util_transform_create()
+* @see image_util_transform_run()
+* @see image_util_transform_destroy()
+*/
+int image_util_transform_run_to(transformation_h handle, media_packet_h src, media_packet_h dst, image_util_transform_completed_cb callback, void *user_data);
+
+/**
+* @brief Transforms the image synchronously for given image util handle.
+* @details The function works like image_util_transform_run(), except that it is done in the calling thread \n
+*          and the result is returned in @a dst instead of the callback. \n
+*          If you set more than two transforming, the order of running is crop or resolution, colorspace converting, rotation. \n
+* @since_tizen 5.5
+*
+* @remarks The @a dst should be released using media_packet_destroy().
+*
+* @param[in] handle The handle of transform
+* @param[in] src The source media packet
+* @param[out] dst The result media packet
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_INVALID_OPERATION Invalid operation
+* @retval #IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT Not supported format
+*
+* @see image_util_transform_create()
+* @see image_util_transform_run()
+* @see image_util_transform_destroy()
+*/
+int image_util_transform_run_sync(transformation_h handle, media_packet_h src, media_packet_h *dst);
+
+/**
+* @brief Transforms the image which is read and written in the strips of the rows for given image util handle.
+* @details The function works like image_util_transform_run_sync() for the images which are too large to be in the memory. \n
+*          The rows of the source are read by @a read_cb and the rows of the result are written by @a write_cb, \n
+*          so only a few strips of the rows are in the memory regardless of the size of the images.
+* @since_tizen 5.5
+*
+* @remarks Only #IMAGE_UTIL_ROTATION_NONE and #IMAGE_UTIL_ROTATION_FLIP_HORZ are supported, \n
+*          the other rotations need the whole source for the first row of the result. \n
+*          The callbacks are called in the calling thread. \n
+*          If a callback returns @c false, the transformation stops and #IMAGE_UTIL_ERROR_CANCELED is returned.
+*
+* @param[in] handle The handle of transform
+* @param[in] colorspace The colorspace of the source
+* @param[in] width The width of the source
+* @param[in] height The height of the source
+* @param[in] read_cb The callback function to read the rows of the source
+* @param[in] write_cb The callback function to write the rows of the result
+* @param[in] user_data The user data to be passed to the callback functions
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_OUT_OF_MEMORY Out of memory
+* @retval #IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT Not supported format or rotation
+* @retval #IMAGE_UTIL_ERROR_CANCELED Stopped by a callback
+*
+* @see image_util_transform_create()
+* @see image_util_transform_run_sync()
+* @see image_util_transform_destroy()
+*/
+int image_util_transform_run_strips(transformation_h handle, image_util_colorspace_e colorspace, unsigned int width, unsigned int height,
+	image_util_transform_read_strip_cb read_cb, image_util_transform_write_strip_cb write_cb, void *user_data);
+
+/**
+* @brief Transforms a region of the image into a tile synchronously for given image util handle.
+* @details The region of @a x, @a y, @a width and @a height of the source is resized to the tile of @a tile_width x @a tile_height, \n
+*          and converted and rotated as the other settings of the handle. \n
+*          Unlike the crop area, the filter of the resizing also uses the pixels around the region like the whole image is resized, \n
+*          so the tiles of the adjacent regions of the same scale are joined without seams. \n
+*          Only the pixels which are used for the tile are read, which is useful for the viewers which pan and zoom a large image.
+* @since_tizen 5.5
+*
+* @remarks The @a dst should be released using media_packet_destroy(). \n
+*          The resolution and the crop area of the handle are not used. \n
+*          @a tile_width and @a tile_height are the size of the result after the rotation. \n
+*          If the region is the tile of the whole image resized to an integer multiple of the tile size, \n
+*          the tile is the same as the part of the whole image transformed by image_util_transform_run_sync().
+*
+* @param[in] handle The handle of transform
+* @param[in] src The source media packet
+* @param[in] x The x position of the region
+* @param[in] y The y position of the region
+* @param[in] width The width of the region
+* @param[in] height The height of the region
+* @param[in] tile_width The width of the result
+* @param[in] tile_height The height of the result
+* @param[out] dst The result media packet
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_OUT_OF_MEMORY Out of memory
+* @retval #IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT Not supported format
+*
+* @see image_util_transform_create()
+* @see image_util_transform_run_sync()
+* @see image_util_transform_destroy()
+*/
+int image_util_transform_run_roi(transformation_h handle, media_packet_h src, unsigned int x, unsigned int y, unsigned int width, unsigned int height,
+	unsigned int tile_width, unsigned int tile_height, media_packet_h *dst);
+
+/**
+* @brief Transforms the images of the media packets with the same settings of given image util handle.
+* @details The function execute asynchronously, and the transformations of the images are spread over the CPU cores. \n
+*          The callback is called once after all images are transformed, with the result of each image. \n
+* @since_tizen 5.5
+*
+* @remarks The batch is queued like image_util_transform_run(), so it takes a slot of the queue of the handle.
+*
+* @param[in] handle The handle of transform
+* @param[in] srcs The array of the source media packets
+* @param[in] num The number of the source media packets
+* @param[in] callback The callback function to be invoked
+* @param[in] user_data The user data to be passed to the callback function
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_INVALID_OPERATION Invalid operation or the queue is full
+* @retval #IMAGE_UTIL_ERROR_OUT_OF_MEMORY Out of memory
+*
+* @see image_util_transform_create()
+* @see image_util_transform_run()
+* @see image_util_transform_destroy()
+*/
+int image_util_transform_run_batch(transformation_h handle, media_packet_h *srcs, unsigned int num, image_util_transform_batch_completed_cb callback, void *user_data);
+
+/**
+* @brief Transforms the image of the media packet into several resolutions with the same settings of given image util handle.
+* @details The function execute asynchronously, and the callback is called once with the results of all resolutions. \n
+*          The resolution of the handle set by image_util_transform_set_resolution() is not used, \n
+*          the source image is cropped, converted and rotated as the other settings of the handle and resized to each resolution. \n
+*          The smaller results are made from the larger results when that is cheaper than scanning the source again.
+* @since_tizen 5.5
+*
+* @remarks The transformation is queued like image_util_transform_run(), so it takes a slot of the queue of the handle. \n
+*          The @a dsts of the callback are in the same order as @a widths and @a heights.
+*
+* @param[in] handle The handle of transform
+* @param[in] src The source media packet
+* @param[in] widths The array of the widths of the results
+* @param[in] heights The array of the heights of the results
+* @param[in] num The number of the results
+* @param[in] callback The callback function to be invoked
+* @param[in] user_data The user data to be passed to the callback function
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_INVALID_OPERATION Invalid operation or the queue is full
+* @retval #IMAGE_UTIL_ERROR_OUT_OF_MEMORY Out of memory
+*
+* @see image_util_transform_create()
+* @see image_util_transform_run()
+* @see image_util_transform_destroy()
+*/
+int image_util_transform_run_multi_resolution(transformation_h handle, media_packet_h src, const unsigned int *widths, const unsigned int *heights, unsigned int num, image_util_transform_batch_completed_cb callback, void *user_data);
+
+/**
+* @brief Cancels the queued transformations of the handle.
+* @details The transformations which are not started yet are dropped, and the running one stops at the next row or tile. \n
+*          The callbacks of the canceled transformations are still called with #IMAGE_UTIL_ERROR_CANCELED.
+* @since_tizen 5.5
+*
+* @remarks The transformations which are submitted after this function are not canceled. \n
+*          Call this function before image_util_transform_destroy() to destroy the handle without waiting the queued transformations.
+*
+* @param[in] handle The handle to image util transform
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+*
+* @see image_util_transform_run()
+* @see image_util_transform_set_deadline()
+*/
+int image_util_transform_cancel(transformation_h handle);
+
+/**
+* @brief Creates a stream which transforms the frames of a video on its own thread.
+* @details The frames are transformed with the settings of @a handle. \n
+*          The frames are pushed by image_util_transform_stream_push() and the results are popped by image_util_transform_stream_pop() in the same order, \n
+*          without creating a thread or calling a callback for each frame.
+* @since_tizen 5.5
+*
+* @remarks The @a stream should be released using image_util_transform_stream_destroy() before destroying @a handle. \n
+*          The settings of @a handle should not be changed while the stream is running. \n
+*          For the frames of the same format and resolution, image_util_transform_prepare() and image_util_transform_set_packet_pool_size() \n
+*          avoid making the filters and the result packets for each frame.
+*
+* @param[in] handle The handle to image util transform
+* @param[in] size The number of the frames which can wait in the input and in the output, up to 64
+* @param[out] stream A handle to the stream
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_INVALID_OPERATION Invalid operation
+* @retval #IMAGE_UTIL_ERROR_OUT_OF_MEMORY Out of memory
+*
+* @pre image_util_transform_create().
+*
+* @see image_util_transform_stream_push()
+* @see image_util_transform_stream_pop()
+* @see image_util_transform_stream_destroy()
+*/
+int image_util_transform_stream_create(transformation_h handle, unsigned int size, transformation_stream_h *stream);
+
+/**
+* @brief Pushes a frame into the stream.
+* @since_tizen 5.5
+*
+* @remarks The function doesn't wait, it fails if the input is full. \n
+*          The @a src is used until it is returned by image_util_transform_stream_pop(). \n
+*          The function should be called in one thread.
+*
+* @param[in] stream The handle to the stream
+* @param[in] src The source media packet
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_INVALID_OPERATION The input is full
+*
+* @see image_util_transform_stream_create()
+* @see image_util_transform_stream_pop()
+*/
+int image_util_transform_stream_push(transformation_stream_h stream, media_packet_h src);
+
+/**
+* @brief Pops the result of the oldest frame from the stream.
+* @since_tizen 5.5
+*
+* @remarks The function doesn't wait, it returns #IMAGE_UTIL_ERROR_NO_DATA if no result is ready. \n
+*          The @a src is the packet which was pushed, and the @a dst should be released using media_packet_destroy(). \n
+*          If the transformation of the frame failed, the error is returned with the @a src and the @a dst is NULL. \n
+*          The function should be called in one thread.
+*
+* @param[in] stream The handle to the stream
+* @param[out] src The source media packet of the frame
+* @param[out] dst The result media packet of the frame
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_NO_DATA No result is ready
+* @retval #IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT Not supported format
+* @retval #IMAGE_UTIL_ERROR_OUT_OF_MEMORY Out of memory
+*
+* @see image_util_transform_stream_create()
+* @see image_util_transform_stream_push()
+*/
+int image_util_transform_stream_pop(transformation_stream_h stream, media_packet_h *src, media_packet_h *dst);
+
+/**
+* @brief Destroys the stream.
+* @since_tizen 5.5
+*
+* @remarks The frame which is being transformed is finished before destroying. \n
+*          The results which are not popped are released, and the sources which are not returned are not.
+*
+* @param[in] stream The handle to the stream
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+*
+* @see image_util_transform_stream_create()
+*/
+int image_util_transform_stream_destroy(transformation_stream_h stream);
+
 /**
 * @brief Destroys a handle to image util.
 * @details The function frees all resources related to the image util handle. The image util
@@ -358,6 +894,9 @@ int image_util_transform_run(transformation_h handle, media_packet_h src, image_
 *               has to be created before the next usage.
 * @since_tizen @if MOBILE 2.3 @elseif WEARABLE 2.3.1 @endif
 *
+* @remarks The queued transformations are done before the handle is destroyed. \n
+*          This function should not be called in image_util_transform_completed_cb().
+*
 * @param[in] handle The handle to image util transform
 *
 * @return @c 0 on success,
@@ -365,6 +904,7 @@ int image_util_transform_run(transformation_h handle, media_packet_h src, image_
 *
 * @retval #IMAGE_UTIL_ERROR_NONE Successful
 * @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_INVALID_OPERATION Invalid operation
 *
 * @see image_util_transform_create()
 *
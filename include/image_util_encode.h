@@ -364,6 +364,29 @@ int image_util_encode_set_output_buffer(image_util_encode_h handle, unsigned cha
 */
 int image_util_encode_run(image_util_encode_h handle, unsigned long long *size);
 
+/**
+* @brief Sets the priority of the asynchronous encoding.
+* @since_tizen 5.5
+*
+* @remarks The default priority is #IMAGE_UTIL_PRIORITY_NORMAL. \n
+*          The priority is applied to the next image_util_encode_run_async().
+*
+* @param[in] handle The handle to image util encoding
+* @param[in] priority The priority of the encoding
+*
+* @return @c 0 on success,
+*                 otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+*
+* @pre image_util_encode_create()
+*
+* @see image_util_encode_run_async()
+* @see image_util_transform_set_priority()
+*/
+int image_util_encode_set_priority(image_util_encode_h handle, image_util_priority_e priority);
+
 /**
 * @brief Starts encoding of the image and fills the output buffer, set using image_util_encode_set_output_buffer() or image_util_encode_set_output_path().
 * @since_tizen 3.0
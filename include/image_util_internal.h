@@ -34,7 +34,9 @@ extern "C"
 * @brief Converts the image's colorspace.
 * @since_tizen 2.3
 *
-* @remarks You must get the @a dest buffer size using image_util_transform_calculate_buffer_size().
+* @remarks You must get the @a dest buffer size using image_util_transform_calculate_buffer_size(). \n
+*          Since 5.5, @a dest can be @a src for converting between #IMAGE_UTIL_COLORSPACE_ARGB8888, #IMAGE_UTIL_COLORSPACE_BGRA8888, \n
+*          #IMAGE_UTIL_COLORSPACE_RGBA8888 and #IMAGE_UTIL_COLORSPACE_BGRX8888.
 *
 * @param[in, out] dest The image buffer for result \n
 *                     Must be allocated by the user
@@ -87,6 +89,36 @@ int image_util_convert_colorspace(unsigned char *dest, image_util_colorspace_e d
 */
 int image_util_resize(unsigned char *dest, int *dest_width, int *dest_height, const unsigned char *src, int src_width, int src_height, image_util_colorspace_e colorspace);
 
+/**
+* @internal
+* @brief Resizes the image to the specified destination width and height with the filter.
+* @since_tizen 5.5
+*
+* @remarks image_util_resize() is the same as this function with #IMAGE_UTIL_RESIZE_FILTER_BILINEAR. \n
+*          Because of YUV format padding, the destination image size can be adjusted, then the filter of mm_util is used instead.
+*
+* @param[in, out] dest The image buffer for result \n
+*                     Must be allocated by the user.
+* @param[in, out] dest_width The image width to resize, and resized width
+* @param[in, out] dest_height The image height to resize, and resized height
+* @param[in] src The image buffer for the original image
+* @param[in] src_width The original image width
+* @param[in] src_height The original image height
+* @param[in] colorspace The image colorspace
+* @param[in] filter The filter of the resizing
+*
+* @return @c 0 on success,
+*               otherwise a negative error value
+*
+* @retval #IMAGE_UTIL_ERROR_NONE Successful
+* @retval #IMAGE_UTIL_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #IMAGE_UTIL_ERROR_INVALID_OPERATION Invalid operation
+*
+* @see image_util_resize()
+* @see image_util_transform_calculate_buffer_size()
+*/
+int image_util_resize_with_filter(unsigned char *dest, int *dest_width, int *dest_height, const unsigned char *src, int src_width, int src_height, image_util_colorspace_e colorspace, image_util_resize_filter_e filter);
+
 /**
 * @internal
 * @brief Rotates the image to the specified angle given in degrees.
@@ -103,6 +135,8 @@ int image_util_resize(unsigned char *dest, int *dest_width, int *dest_height, co
 * #IMAGE_UTIL_COLORSPACE_BGRA8888\n
 * #IMAGE_UTIL_COLORSPACE_RGBA8888\n
 * #IMAGE_UTIL_COLORSPACE_BGRX8888\n.
+* @a dest can be @a src for #IMAGE_UTIL_ROTATION_180, #IMAGE_UTIL_ROTATION_FLIP_HORZ and #IMAGE_UTIL_ROTATION_FLIP_VERT, \n
+* then the image is flipped in place without another buffer if its width and height are even for the YUV color spaces.
 *
 * @param[in, out] dest The image buffer for result \n
 *                     Must be allocated by the user.
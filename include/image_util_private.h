@@ -18,6 +18,7 @@
 #define __TIZEN_MULTIMEDIA_IMAGE_UTIL_PRIVATE_H__
 
 #include <image_util_type.h>
+#include <image_util_transform_private.h>
 #include <dlog.h>
 #include <stdlib.h>
 #include <glib.h>
@@ -94,21 +95,77 @@ extern "C"
 
 #define NUM_OF_COLORSPACE	get_number_of_colorspace()
 
+#define TRANSFORM_DEFAULT_QUEUE_DEPTH	4
+#define TRANSFORM_FORMAT_CACHE_SIZE	4
+
 typedef gboolean(*ModuleFunc)(void *, int, int, unsigned char *, unsigned char *, unsigned char *);
 
 typedef struct {
 	void *user_data;
+	media_packet_h src;
 	media_packet_h dst;
 	image_util_transform_completed_cb completed_cb;
+
+	/* for batch */
+	media_packet_h *srcs;
+	media_packet_h *dsts;
+	int *errors;
+	unsigned int num;
+	image_util_transform_batch_completed_cb batch_completed_cb;
+
+	/* for multi resolution, the results are in dsts */
+	unsigned int *widths;
+	unsigned int *heights;
+
+	gint canceled;
+	gint64 deadline;	/* monotonic time, 0 for no deadline */
 } image_util_cb_s;
 
+typedef struct {
+	media_format_mimetype_e mimetype;
+	unsigned int width;
+	unsigned int height;
+	media_format_h format;
+} format_cache_s;
+
+typedef struct _packet_pool_s packet_pool_s;
+
+typedef struct {
+	packet_pool_s *pool;
+	media_packet_h packet;
+	media_format_mimetype_e mimetype;
+	unsigned int width;
+	unsigned int height;
+	bool discard;
+} pool_packet_s;
+
+/* referenced by the handle and by each packet made from the pool */
+struct _packet_pool_s {
+	gint ref_count;
+	GMutex mutex;
+	GQueue packets;		/* pool_packet_s which are returned by media_packet_destroy() */
+	unsigned int size;
+	bool closed;
+};
+
+/* the plan of image_util_transform_prepare() and the source which it is made for */
+typedef struct {
+	transform_plan_s *plan;
+	media_format_mimetype_e mimetype;
+	unsigned int width;
+	unsigned int height;
+	image_util_colorspace_e colorspace;
+	image_util_colorspace_e dst_colorspace;
+	unsigned int dst_width;
+	unsigned int dst_height;
+} prepared_plan_s;
+
 typedef struct {
 	media_packet_h src;
 	media_packet_h dst;
 	image_util_colorspace_e colorspace;
 	image_util_rotation_e dest_rotation;
 	void *image_h;
-	image_util_cb_s *_util_cb;
 	unsigned int width;
 	unsigned int height;
 	image_util_rotation_e rotation;
@@ -120,8 +177,58 @@ typedef struct {
 	bool set_resize;
 	bool set_rotate;
 	bool set_crop;
+	bool dither;		/* the ordered dither for RGB565 */
+	image_util_resize_filter_e resize_filter;
+	unsigned int max_threads;	/* the threads of a run, 0 for the number of the processors */
+
+	/* for async, image_util_cb_s jobs in the order of submission, run one by one on the scheduler */
+	GMutex job_mutex;
+	GCond job_cond;
+	GQueue job_queue;
+	unsigned int queue_depth;
+	unsigned int timeout;	/* the deadline of the jobs in milliseconds after the submission, 0 for no deadline */
+	image_util_priority_e priority;
+	bool running;
+	GThread *worker;		/* the thread which is running the job now */
+
+	/* for the result packets, the oldest format is replaced */
+	GMutex packet_mutex;
+	format_cache_s formats[TRANSFORM_FORMAT_CACHE_SIZE];
+	unsigned int next_format;
+	packet_pool_s *pool;
+
+	/* dropped when the settings are changed */
+	GMutex plan_mutex;
+	prepared_plan_s prepared;
 } transformation_s;
 
+typedef struct {
+	media_packet_h src;
+	media_packet_h dst;
+	int error;
+} stream_frame_s;
+
+/* the ring of one producer and one consumer, the counters only increase and the index is the counter & mask */
+typedef struct {
+	stream_frame_s *frames;
+	unsigned int mask;
+	gint head;		/* the next frame to read, written only by the consumer */
+	gint tail;		/* the next frame to write, written only by the producer */
+} stream_ring_s;
+
+typedef struct {
+	transformation_s *handle;
+	stream_ring_s input;	/* the application to the thread */
+	stream_ring_s output;	/* the thread to the application */
+	GThread *thread;
+
+	/* only for the thread which sleeps when the input is empty or the output is full */
+	GMutex mutex;
+	GCond cond;
+	gint sleeping;
+	gint quit;
+} transformation_stream_s;
+
 typedef struct {
 	void *user_data;
 	image_util_decode_completed_cb image_decode_completed_cb;
@@ -154,8 +261,11 @@ typedef struct {
 	decode_cb_s *_decode_cb;
 	encode_cb_s *_encode_cb;
 
-	/* for async */
-	GThread *thread;
+	/* for async, runs on the scheduler */
+	image_util_priority_e priority;
+	GMutex async_mutex;
+	GCond async_cond;
+	bool running;
 } decode_encode_s;
 
 typedef struct {
@@ -194,6 +304,23 @@ int convert_type_of_colorspace_with_image_type(const image_util_colorspace_e col
 int _image_error_capi(image_util_error_type_e error_type, int error_code);
 bool _image_util_check_resolution(int width, int height);
 
+/* image_util.c */
+int _image_util_transform_sync(transformation_s *_handle, image_util_cb_s *_util_cb, media_packet_h src, media_packet_h *dst);
+
+/* image_util_scheduler.c */
+typedef void (*scheduler_work_func)(void *data);
+int _image_util_scheduler_push(image_util_priority_e priority, scheduler_work_func func, void *data);
+
+/*
+ * runs @func for the @count indexes on up to @max_threads threads (0 for the number of the processors) with the calling one,
+ * and returns the first error of them after all are done, *@local is the state of each thread, the works on the scheduler
+ * start with NULL and free it by @free_local, the calling thread starts with @local which stays with the caller
+ */
+typedef int (*scheduler_parallel_func)(void *data, unsigned int index, void **local);
+typedef void (*scheduler_local_free_func)(void *local);
+int _image_util_scheduler_run_parallel(image_util_priority_e priority, unsigned int count, unsigned int max_threads,
+	scheduler_parallel_func func, scheduler_local_free_func free_local, void *data, void *local);
+
 /**
 * @}
 */
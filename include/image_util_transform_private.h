@@ -0,0 +1,227 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef __TIZEN_MULTIMEDIA_IMAGE_UTIL_TRANSFORM_PRIVATE_H__
+#define __TIZEN_MULTIMEDIA_IMAGE_UTIL_TRANSFORM_PRIVATE_H__
+
+#include <image_util_type.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define TRANSFORM_MAX_PLANES	3
+
+/* the pixels between the stages of the transform are 4 bytes, RGBA or YUVA */
+#define TRANSFORM_PIXEL_SIZE	4
+
+/* the fraction bits of the weights of the resampling */
+#define TRANSFORM_FILTER_BITS	14
+
+typedef enum {
+	TRANSFORM_DOMAIN_YUV,
+	TRANSFORM_DOMAIN_RGB,
+} transform_domain_e;
+
+typedef struct {
+	image_util_colorspace_e colorspace;
+	unsigned int width;
+	unsigned int height;
+	unsigned char *planes[TRANSFORM_MAX_PLANES];	/* Y or RGB, U or UV or VU, V */
+	unsigned int strides[TRANSFORM_MAX_PLANES];
+} transform_image_s;
+
+typedef struct {
+	unsigned int x;
+	unsigned int y;
+	unsigned int width;
+	unsigned int height;
+} transform_area_s;
+
+/* reads @width pixels from (@x, @y) of @image into @row */
+typedef void (*transform_unpack_func)(const transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, unsigned char *row);
+
+/* writes @row0 to the line @y and @row1 to the line @y + 1, @row1 is NULL for the last odd line */
+typedef void (*transform_pack_func)(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1);
+
+/* called at every row or tile, the transform stops and returns the error if it is not IMAGE_UTIL_ERROR_NONE */
+typedef int (*transform_check_func)(void *user_data);
+
+/*
+ * fills @buffer of @size with the @rows rows from @y of the source, which are an image of the source width x @rows,
+ * the rows are read once in increasing order, the transform stops and returns the error if it is not IMAGE_UTIL_ERROR_NONE
+ */
+typedef int (*transform_read_func)(unsigned int y, unsigned int rows, unsigned char *buffer, size_t size, void *user_data);
+
+/* takes the @rows rows from @y of the destination in @buffer of @size, which are an image of the destination width x @rows */
+typedef int (*transform_write_func)(unsigned int y, unsigned int rows, const unsigned char *buffer, size_t size, void *user_data);
+
+typedef struct {
+	transform_domain_e domain;
+	unsigned int num_planes;
+	unsigned int h_shift;	/* horizontal chroma subsampling */
+	unsigned int v_shift;	/* vertical chroma subsampling */
+	transform_unpack_func unpack;
+	transform_pack_func pack;
+} transform_format_s;
+
+/* the order of the channels of the 4 bytes RGB pixels which the row kernels write */
+typedef enum {
+	TRANSFORM_ORDER_RGBA,
+	TRANSFORM_ORDER_BGRA,
+	TRANSFORM_ORDER_ARGB,
+} transform_order_e;
+
+/*
+ * converts @width pixels of a YUV row which starts at an even x into 4 bytes RGB pixels of @order,
+ * @uv_step is 1 for the planar chroma and 2 for the interleaved chroma
+ */
+typedef void (*transform_yuv_to_rgb_func)(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int uv_step, unsigned char *out, unsigned int width, transform_order_e order);
+
+/*
+ * converts the 2 rows of @width 4 bytes RGB pixels of @order into the 2 lines of Y and a line of 4:2:0 chroma,
+ * @row1 and @py1 are NULL for the last odd line, @uv_step is 1 for the planar chroma and 2 for the interleaved chroma
+ */
+typedef void (*transform_rgb_to_yuv_func)(const unsigned char *row0, const unsigned char *row1, unsigned char *py0, unsigned char *py1, unsigned char *pu, unsigned char *pv, unsigned int uv_step, unsigned int width, transform_order_e order);
+
+/* the input byte of each byte of the output pixel, -1 for 0xff, for reordering the bytes of the RGB pixels */
+typedef struct {
+	unsigned int in_bpp;
+	unsigned int out_bpp;
+	int map[4];
+} transform_swizzle_s;
+
+/* reorders @width pixels by @swizzle, @in and @out can be the same row if the pixels have the same size */
+typedef void (*transform_swizzle_func)(const unsigned char *in, unsigned char *out, unsigned int width, const transform_swizzle_s *swizzle);
+
+/* the kernels which move the planes of the 4:2:x YUV rows between the layouts, @count is the number of the chroma */
+typedef struct {
+	void (*split_uv)(const unsigned char *uv, unsigned char *u, unsigned char *v, unsigned int count);
+	void (*merge_uv)(const unsigned char *u, const unsigned char *v, unsigned char *uv, unsigned int count);
+	/* @y_idx is 0 for YUYV and 1 for UYVY */
+	void (*split_packed)(const unsigned char *in, unsigned int y_idx, unsigned char *py, unsigned char *pu, unsigned char *pv, unsigned int width);
+	void (*merge_packed)(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int y_idx, unsigned char *out, unsigned int width);
+	/* the rounded averages of the chroma of 2 lines */
+	void (*average)(const unsigned char *a, const unsigned char *b, unsigned char *out, unsigned int count);
+} transform_yuv_kernels_s;
+
+/* the kernels between RGB565 and the 4 bytes RGB pixels of @order */
+typedef struct {
+	void (*unpack)(const unsigned char *in, unsigned char *out, unsigned int width, transform_order_e order);
+	/* @dither is the row of the 4x4 ordered dither from the first pixel, NULL for truncating */
+	void (*pack)(const unsigned char *in, unsigned char *out, unsigned int width, transform_order_e order, const unsigned char *dither);
+} transform_rgb565_kernels_s;
+
+/*
+ * the kernels of the separable resampling, the output sample i of the horizontal one is the sum of @count[i] pixels from
+ * @first[i] weighted by the @taps weights of i, and the vertical one sums the bytes of the @count rows weighted by @weights,
+ * the sums of the weights are (1 << TRANSFORM_FILTER_BITS)
+ */
+typedef struct {
+	void (*h)(const unsigned char *in, unsigned char *out, unsigned int width, const unsigned int *first, const unsigned int *count, const short *weights, unsigned int taps);
+	void (*v)(const unsigned char *const *rows, const short *weights, unsigned int count, unsigned char *out, unsigned int size);
+	/* the 2x2 box of @width pixels of 2 rows into (@width + 1) / 2 pixels, for the halving before the large downscales */
+	void (*halve)(const unsigned char *row0, const unsigned char *row1, unsigned char *out, unsigned int width);
+	/* the rounded averages of @count bytes of 2 rows, for the vertical only halving */
+	void (*average)(const unsigned char *a, const unsigned char *b, unsigned char *out, unsigned int count);
+} transform_resample_kernels_s;
+
+/*
+ * writes the @width x @height samples of @in transposed into @out, the row x of @out is the column x of @in,
+ * the strides can be negative for the rotations, the samples are 1 to 4 bytes as the index of the array plus 1
+ */
+typedef void (*transform_transpose_func)(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height);
+
+typedef struct {
+	transform_transpose_func transpose[4];
+} transform_transpose_kernels_s;
+
+/* writes the @count samples of @in in reverse order into @out, @in and @out can be the same row, the samples are as the transposes */
+typedef void (*transform_reverse_func)(const unsigned char *in, unsigned char *out, unsigned int count);
+
+typedef struct {
+	transform_reverse_func reverse[4];
+} transform_reverse_kernels_s;
+
+/*
+ * the options of the transform, NULL is for the defaults, no dither, the bilinear filter, the threads of all the processors
+ * and the normal priority
+ */
+typedef struct {
+	bool dither;	/* the ordered dither for RGB565 */
+	image_util_resize_filter_e filter;
+	unsigned int max_threads;	/* the threads of a run, 0 for the number of the processors */
+	image_util_priority_e priority;	/* of the bands which run on the scheduler */
+} transform_options_s;
+
+/* the filters, the kernels and the buffers of a transform, which are shared by the frames of the same geometry */
+typedef struct _transform_plan_s transform_plan_s;
+
+/* image_util_color.c */
+const transform_format_s *_transform_get_format(image_util_colorspace_e colorspace);
+size_t _transform_get_buffer_size(image_util_colorspace_e colorspace, unsigned int width, unsigned int height);
+int _transform_set_image(transform_image_s *image, image_util_colorspace_e colorspace, unsigned int width, unsigned int height, void *buffer, size_t size);
+int _transform_set_planes(transform_image_s *image, image_util_colorspace_e colorspace, unsigned int width, unsigned int height, unsigned char **planes, const unsigned int *strides, unsigned int num_planes);
+void _transform_convert_row(unsigned char *row, unsigned int width, transform_domain_e from, transform_domain_e to);
+void _transform_yuv_to_rgb_row(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int uv_step, unsigned char *out, unsigned int width, transform_order_e order);
+void _transform_rgb_to_yuv_row(const unsigned char *row0, const unsigned char *row1, unsigned char *py0, unsigned char *py1, unsigned char *pu, unsigned char *pv, unsigned int uv_step, unsigned int width, transform_order_e order);
+void _transform_split_uv(const unsigned char *uv, unsigned char *u, unsigned char *v, unsigned int count);
+void _transform_merge_uv(const unsigned char *u, const unsigned char *v, unsigned char *uv, unsigned int count);
+void _transform_split_packed(const unsigned char *in, unsigned int y_idx, unsigned char *py, unsigned char *pu, unsigned char *pv, unsigned int width);
+void _transform_merge_packed(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int y_idx, unsigned char *out, unsigned int width);
+void _transform_average(const unsigned char *a, const unsigned char *b, unsigned char *out, unsigned int count);
+bool _transform_get_swizzle(image_util_colorspace_e from, image_util_colorspace_e to, transform_swizzle_s *swizzle);
+void _transform_swizzle_row(const unsigned char *in, unsigned char *out, unsigned int width, const transform_swizzle_s *swizzle);
+const unsigned char *_transform_get_dither_row(unsigned int y);
+void _transform_unpack_rgb565_row(const unsigned char *in, unsigned char *out, unsigned int width, transform_order_e order);
+void _transform_pack_rgb565_row(const unsigned char *in, unsigned char *out, unsigned int width, transform_order_e order, const unsigned char *dither);
+void _transform_pack_rgb565_dither(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1);
+
+/* image_util_simd.c */
+transform_yuv_to_rgb_func _transform_get_yuv_to_rgb_func(void);
+transform_rgb_to_yuv_func _transform_get_rgb_to_yuv_func(void);
+const transform_yuv_kernels_s *_transform_get_yuv_kernels(void);
+transform_swizzle_func _transform_get_swizzle_func(void);
+const transform_rgb565_kernels_s *_transform_get_rgb565_kernels(void);
+const transform_resample_kernels_s *_transform_get_resample_kernels(void);
+const transform_transpose_kernels_s *_transform_get_transpose_kernels(void);
+const transform_reverse_kernels_s *_transform_get_reverse_kernels(void);
+
+/* image_util_transform.c */
+void _transform_resample_h_row(const unsigned char *in, unsigned char *out, unsigned int width, const unsigned int *first, const unsigned int *count, const short *weights, unsigned int taps);
+void _transform_resample_v_row(const unsigned char *const *rows, const short *weights, unsigned int count, unsigned char *out, unsigned int size);
+void _transform_halve_row(const unsigned char *row0, const unsigned char *row1, unsigned char *out, unsigned int width);
+void _transform_transpose(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height, unsigned int size);
+void _transform_reverse(const unsigned char *in, unsigned char *out, unsigned int count, unsigned int size);
+void _transform_get_output_size(unsigned int width, unsigned int height, image_util_rotation_e rotation, unsigned int *out_width, unsigned int *out_height);
+int _transform_plan_create(image_util_colorspace_e src_colorspace, unsigned int src_width, unsigned int src_height, const transform_area_s *area, image_util_rotation_e rotation,
+	image_util_colorspace_e dst_colorspace, unsigned int dst_width, unsigned int dst_height, const transform_options_s *options, transform_plan_s **plan);
+int _transform_plan_create_roi(image_util_colorspace_e src_colorspace, unsigned int src_width, unsigned int src_height, const transform_area_s *roi, image_util_rotation_e rotation,
+	image_util_colorspace_e dst_colorspace, unsigned int dst_width, unsigned int dst_height, const transform_options_s *options, transform_plan_s **plan);
+transform_plan_s *_transform_plan_ref(transform_plan_s *plan);
+void _transform_plan_unref(transform_plan_s *plan);
+int _transform_plan_run(transform_plan_s *plan, const transform_image_s *src, transform_image_s *dst, transform_check_func check, void *check_data);
+int _transform_plan_run_strips(transform_plan_s *plan, transform_read_func read, transform_write_func write, void *user_data, transform_check_func check, void *check_data);
+int _transform_run(const transform_image_s *src, const transform_area_s *area, image_util_rotation_e rotation, const transform_options_s *options, transform_image_s *dst, transform_check_func check, void *check_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIZEN_MULTIMEDIA_IMAGE_UTIL_TRANSFORM_PRIVATE_H__ */
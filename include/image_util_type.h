@@ -54,7 +54,10 @@ typedef enum {
 	IMAGE_UTIL_ERROR_INVALID_OPERATION =	TIZEN_ERROR_INVALID_OPERATION,   /**< Internal error */
 	IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT = TIZEN_ERROR_IMAGE_UTIL | 0x01,   /**< Not supported format */
 	IMAGE_UTIL_ERROR_PERMISSION_DENIED =	TIZEN_ERROR_PERMISSION_DENIED,   /**< Permission denied  */
-	IMAGE_UTIL_ERROR_NOT_SUPPORTED =		TIZEN_ERROR_NOT_SUPPORTED          /**< Not supported */
+	IMAGE_UTIL_ERROR_NOT_SUPPORTED =		TIZEN_ERROR_NOT_SUPPORTED,          /**< Not supported */
+	IMAGE_UTIL_ERROR_CANCELED =			TIZEN_ERROR_CANCELED,            /**< Canceled (Since 5.5) */
+	IMAGE_UTIL_ERROR_TIMED_OUT =			TIZEN_ERROR_TIMED_OUT,           /**< Deadline expired (Since 5.5) */
+	IMAGE_UTIL_ERROR_NO_DATA =			TIZEN_ERROR_NO_DATA              /**< No data available (Since 5.5) */
 } image_util_error_e;
 
 /**
@@ -82,6 +85,31 @@ typedef enum {
 	IMAGE_UTIL_COLORSPACE_NV61,	 /**< NV61- planar */
 } image_util_colorspace_e;
 
+/**
+ * @brief Enumeration for the priority of the asynchronous works.
+ * @details The works of all handles share the worker threads of the process, \n
+ *          and the work of the higher priority is always started first.
+ * @since_tizen 5.5
+ */
+typedef enum {
+	IMAGE_UTIL_PRIORITY_LOW,	/**< Low priority, for background works */
+	IMAGE_UTIL_PRIORITY_NORMAL,	/**< Normal priority, the default */
+	IMAGE_UTIL_PRIORITY_HIGH,	/**< High priority, for interactive works */
+} image_util_priority_e;
+
+/**
+ * @brief Enumeration for the filters of the resizing.
+ * @details The sharper filters take more time, especially for the large downscales.
+ * @since_tizen 5.5
+ */
+typedef enum {
+	IMAGE_UTIL_RESIZE_FILTER_NEAREST,	/**< Nearest neighbor, the fastest, for the previews */
+	IMAGE_UTIL_RESIZE_FILTER_BILINEAR,	/**< Bilinear, the default */
+	IMAGE_UTIL_RESIZE_FILTER_BOX,		/**< Box, the average of the covered area, for the thumbnails */
+	IMAGE_UTIL_RESIZE_FILTER_BICUBIC,	/**< Bicubic (Catmull-Rom) */
+	IMAGE_UTIL_RESIZE_FILTER_LANCZOS3,	/**< Lanczos with 3 lobes, the sharpest */
+} image_util_resize_filter_e;
+
 /**
  * @}
  */
@@ -111,6 +139,13 @@ typedef enum {
 */
 typedef struct transformation_s *transformation_h;
 
+/**
+* @ingroup CAPI_MEDIA_IMAGE_UTIL_TRANSFORM_MODULE
+* @brief Image util transform stream handle.
+* @since_tizen 5.5
+*/
+typedef struct transformation_stream_s *transformation_stream_h;
+
 /**
 * @ingroup CAPI_MEDIA_IMAGE_UTIL_TRANSFORM_MODULE
 * @brief Called when transform is finished just before returning the output.
@@ -126,6 +161,66 @@ typedef struct transformation_s *transformation_h;
 */
 typedef void(*image_util_transform_completed_cb)(media_packet_h *dst, int error_code, void *user_data);
 
+/**
+* @ingroup CAPI_MEDIA_IMAGE_UTIL_TRANSFORM_MODULE
+* @brief Called when the batch transform is finished just before returning the output.
+* @since_tizen 5.5
+*
+* @remarks The packets in @a dsts should be released using media_packet_destroy(), \n
+*          but @a dsts and @a error_codes themselves are released after the callback returns. \n
+*          If @a error_codes[i] is not #IMAGE_UTIL_ERROR_NONE, @a dsts[i] is NULL. \n
+*          The callback is called in a separate thread(not in the main loop).
+*
+* @param[in,out] dsts The result buffers of image util transform, in the order of the sources
+* @param[in] error_codes The error codes of image util transform, in the order of the sources
+* @param[in] num The number of the results
+* @param[in] user_data The user data passed from the callback registration function
+* @pre image_util_transform_run_batch() will invoke this function.
+*/
+typedef void(*image_util_transform_batch_completed_cb)(media_packet_h *dsts, int *error_codes, unsigned int num, void *user_data);
+
+/**
+* @ingroup CAPI_MEDIA_IMAGE_UTIL_TRANSFORM_MODULE
+* @brief Called to read a strip of the rows of the source by image_util_transform_run_strips().
+* @since_tizen 5.5
+*
+* @remarks The strips are read once in increasing order from the first row of the crop area, rounded down to the even row. \n
+*          The last rows which are not used for the result may not be read. \n
+*          @a buffer is the image of the source width x @a rows in the colorspace of the source, \n
+*          tightly packed as image_util_calculate_buffer_size() calculates. \n
+*          The callback is called in the thread of image_util_transform_run_strips().
+*
+* @param[in] y The first row of the strip
+* @param[in] rows The number of the rows of the strip
+* @param[out] buffer The buffer to be filled with the rows
+* @param[in] size The size of @a buffer
+* @param[in] user_data The user data passed from the function
+* @return @c true to continue, otherwise @c false to stop the transformation
+* @pre image_util_transform_run_strips() will invoke this function.
+*/
+typedef bool(*image_util_transform_read_strip_cb)(unsigned int y, unsigned int rows, unsigned char *buffer, unsigned int size, void *user_data);
+
+/**
+* @ingroup CAPI_MEDIA_IMAGE_UTIL_TRANSFORM_MODULE
+* @brief Called to write a strip of the rows of the result by image_util_transform_run_strips().
+* @since_tizen 5.5
+*
+* @remarks The strips are written once in increasing order from the first row. \n
+*          @a buffer is the image of the result width x @a rows in the colorspace of the result, \n
+*          tightly packed as image_util_calculate_buffer_size() calculates. \n
+*          @a buffer is reused for the next strip, so it should be copied to be used after the callback returns. \n
+*          The callback is called in the thread of image_util_transform_run_strips().
+*
+* @param[in] y The first row of the strip
+* @param[in] rows The number of the rows of the strip
+* @param[in] buffer The rows of the result
+* @param[in] size The size of @a buffer
+* @param[in] user_data The user data passed from the function
+* @return @c true to continue, otherwise @c false to stop the transformation
+* @pre image_util_transform_run_strips() will invoke this function.
+*/
+typedef bool(*image_util_transform_write_strip_cb)(unsigned int y, unsigned int rows, const unsigned char *buffer, unsigned int size, void *user_data);
+
 /**
  * @}
  */
@@ -21,6 +21,7 @@
 
 #include <image_util.h>
 #include <image_util_private.h>
+#include <image_util_transform_private.h>
 
 typedef struct {
 	mm_util_color_format_e image_format;
@@ -113,21 +114,15 @@ static int __create_media_format(media_format_mimetype_e mimetype, unsigned int
 	return IMAGE_UTIL_ERROR_NONE;
 }
 
-static int _image_util_packet_to_image(media_packet_h packet, mm_util_color_image_h *color_image)
+static int __get_packet_image(media_packet_h packet, media_format_mimetype_e *mimetype, int *width, int *height, void **ptr, uint64_t *size)
 {
 	int err = IMAGE_UTIL_ERROR_NONE;
-	media_format_mimetype_e mimetype = 0;
-	int width = 0, height = 0;
-	uint64_t size = 0;
-	void *ptr = NULL;
 	media_format_h fmt = NULL;
 
-	image_util_retvm_if(((packet == NULL) || (color_image == NULL)), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid parameter");
-
 	err = media_packet_get_format(packet, &fmt);
 	image_util_retvm_if((err != MEDIA_PACKET_ERROR_NONE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "media_packet_get_format failed (%d)", err);
 
-	err = media_format_get_video_info(fmt, &mimetype, &width, &height, NULL, NULL);
+	err = media_format_get_video_info(fmt, mimetype, width, height, NULL, NULL);
 	if (err != MEDIA_FORMAT_ERROR_NONE) {
 		image_util_error("media_packet_get_format failed (%d)", err);
 		media_format_unref(fmt);
@@ -135,102 +130,880 @@ static int _image_util_packet_to_image(media_packet_h packet, mm_util_color_imag
 	}
 	media_format_unref(fmt);
 
-	err = media_packet_get_buffer_size(packet, &size);
+	err = media_packet_get_buffer_size(packet, size);
 	image_util_retvm_if((err != MEDIA_PACKET_ERROR_NONE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "media_packet_get_buffer_size failed (%d)", err);
 
-	if (size) {
-		err = media_packet_get_buffer_data_ptr(packet, &ptr);
+	if (*size) {
+		err = media_packet_get_buffer_data_ptr(packet, ptr);
 		image_util_retvm_if((err != MEDIA_PACKET_ERROR_NONE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "media_packet_get_buffer_data_ptr failed (%d)", err);
 	}
 
-	image_util_debug("[Fotmat: %u] W x H : %d x %d", mimetype, width, height);
-	image_util_retvm_if(((width == 0) || (height == 0) || (size == 0) || (ptr == NULL)), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source packet");
+	image_util_debug("[Fotmat: %u] W x H : %d x %d", *mimetype, *width, *height);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* gets a reference of the cached format, or creates and caches it */
+static int __get_media_format(transformation_s *_handle, media_format_mimetype_e mimetype, unsigned int width, unsigned int height, media_format_h *fmt)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	format_cache_s *cache = NULL;
+	unsigned int idx = 0;
+
+	g_mutex_lock(&_handle->packet_mutex);
+
+	for (idx = 0; idx < TRANSFORM_FORMAT_CACHE_SIZE; idx++) {
+		cache = &_handle->formats[idx];
+		if (cache->format && cache->mimetype == mimetype && cache->width == width && cache->height == height) {
+			media_format_ref(cache->format);
+			*fmt = cache->format;
+			g_mutex_unlock(&_handle->packet_mutex);
+			return IMAGE_UTIL_ERROR_NONE;
+		}
+	}
+
+	err = __create_media_format(mimetype, width, height, fmt);
+	if (err != IMAGE_UTIL_ERROR_NONE) {
+		g_mutex_unlock(&_handle->packet_mutex);
+		image_util_error("__create_media_format failed (%d)", err);
+		return err;
+	}
+
+	cache = &_handle->formats[_handle->next_format];
+	if (cache->format)
+		media_format_unref(cache->format);
 
-	err = mm_util_create_color_image(color_image, (unsigned long)width, (unsigned long)height, __mimetype_to_image_format(mimetype), ptr, (size_t)size);
-	image_util_retvm_if((err != MM_UTIL_ERROR_NONE), _image_error_capi(ERR_TYPE_TRANSFORM, err), "mm_util_create_color_image failed (%d)", err);
+	media_format_ref(*fmt);
+	cache->mimetype = mimetype;
+	cache->width = width;
+	cache->height = height;
+	cache->format = *fmt;
+	_handle->next_format = (_handle->next_format + 1) % TRANSFORM_FORMAT_CACHE_SIZE;
 
-	image_util_debug("_image_util_packet_to_image succeed");
+	g_mutex_unlock(&_handle->packet_mutex);
 
 	return IMAGE_UTIL_ERROR_NONE;
 }
 
-static int _image_util_image_to_packet(mm_util_color_image_h image, media_packet_h *packet)
+static void __clear_media_formats(transformation_s *_handle)
 {
-	int err = IMAGE_UTIL_ERROR_NONE;
-	mm_util_color_format_e format = 0;
-	unsigned long width = 0, height = 0;
-	void *buffer = NULL;
-	size_t buffer_size = 0;
-	media_format_h fmt = NULL;
-	void *packet_ptr = NULL;
-	uint64_t packet_size = 0;
-	size_t size = 0;
+	unsigned int idx = 0;
+
+	for (idx = 0; idx < TRANSFORM_FORMAT_CACHE_SIZE; idx++) {
+		if (_handle->formats[idx].format) {
+			media_format_unref(_handle->formats[idx].format);
+			_handle->formats[idx].format = NULL;
+		}
+	}
+}
+
+static void __pool_unref(packet_pool_s *pool)
+{
+	if (!g_atomic_int_dec_and_test(&pool->ref_count))
+		return;
+
+	g_mutex_clear(&pool->mutex);
+	IMAGE_UTIL_SAFE_FREE(pool);
+}
+
+static int __pool_packet_finalize(media_packet_h packet, int error_code, void *user_data)
+{
+	pool_packet_s *item = (pool_packet_s *) user_data;
+	packet_pool_s *pool = item->pool;
+
+	g_mutex_lock(&pool->mutex);
+	if (!item->discard && !pool->closed && g_queue_get_length(&pool->packets) < pool->size) {
+		g_queue_push_tail(&pool->packets, item);
+		g_mutex_unlock(&pool->mutex);
+		return MEDIA_PACKET_REUSE_BUFFER;
+	}
+	g_mutex_unlock(&pool->mutex);
+
+	IMAGE_UTIL_SAFE_FREE(item);
+	__pool_unref(pool);
+
+	return MEDIA_PACKET_FINALIZE;
+}
+
+/* the returned packets are freed, the packets in use are freed when they are destroyed */
+static void __pool_close(packet_pool_s *pool)
+{
+	pool_packet_s *item = NULL;
+
+	g_mutex_lock(&pool->mutex);
+	pool->closed = true;
+	while ((item = (pool_packet_s *) g_queue_pop_head(&pool->packets)) != NULL) {
+		g_mutex_unlock(&pool->mutex);
+		media_packet_destroy(item->packet);
+		g_mutex_lock(&pool->mutex);
+	}
+	g_mutex_unlock(&pool->mutex);
 
-	err = mm_util_get_color_image(image, &width, &height, &format, &buffer, &buffer_size);
-	image_util_retvm_if((err != MM_UTIL_ERROR_NONE), _image_error_capi(ERR_TYPE_TRANSFORM, err), "mm_util_get_color_image failed (%d)", err);
+	__pool_unref(pool);
+}
+
+static media_packet_h __pool_get_packet(packet_pool_s *pool, media_format_mimetype_e mimetype, unsigned int width, unsigned int height)
+{
+	pool_packet_s *item = NULL;
+	pool_packet_s *victim = NULL;
+	GList *iter = NULL;
+
+	g_mutex_lock(&pool->mutex);
+
+	for (iter = pool->packets.head; iter; iter = iter->next) {
+		item = (pool_packet_s *) iter->data;
+		if (item->mimetype == mimetype && item->width == width && item->height == height) {
+			g_queue_delete_link(&pool->packets, iter);
+			g_mutex_unlock(&pool->mutex);
+			return item->packet;
+		}
+	}
+
+	/* makes a room for the new packet by freeing the oldest one of the other resolution */
+	if (g_queue_get_length(&pool->packets) >= pool->size) {
+		victim = (pool_packet_s *) g_queue_pop_head(&pool->packets);
+		victim->discard = true;
+	}
+
+	g_mutex_unlock(&pool->mutex);
+
+	if (victim)
+		media_packet_destroy(victim->packet);
+
+	return NULL;
+}
+
+static int __pool_create_packet(packet_pool_s *pool, media_format_h fmt, media_format_mimetype_e mimetype, unsigned int width, unsigned int height, media_packet_h *packet)
+{
+	int err = MEDIA_PACKET_ERROR_NONE;
+	pool_packet_s *item = NULL;
 
-	err = __create_media_format(__image_format_to_mimetype(format), (unsigned int)width, (unsigned int)height, &fmt);
-	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__create_media_format failed (%d)", err);
+	item = (pool_packet_s *) calloc(1, sizeof(pool_packet_s));
+	image_util_retvm_if((item == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Memory allocation failed");
 
-	err = media_packet_create_alloc(fmt, NULL, NULL, packet);
+	item->pool = pool;
+	item->mimetype = mimetype;
+	item->width = width;
+	item->height = height;
+
+	err = media_packet_create_alloc(fmt, __pool_packet_finalize, item, packet);
 	if (err != MEDIA_PACKET_ERROR_NONE) {
 		image_util_error("media_packet_create_alloc failed (%d)", err);
-		media_format_unref(fmt);
+		IMAGE_UTIL_SAFE_FREE(item);
 		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
 	}
 
-	err = media_packet_get_buffer_size(*packet, &packet_size);
+	item->packet = *packet;
+	g_atomic_int_inc(&pool->ref_count);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static int __alloc_packet(transformation_s *_handle, media_format_mimetype_e mimetype, unsigned int width, unsigned int height, media_packet_h *packet, void **packet_ptr, uint64_t *packet_size)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	media_format_h fmt = NULL;
+	packet_pool_s *pool = NULL;
+
+	g_mutex_lock(&_handle->packet_mutex);
+	pool = _handle->pool;
+	if (pool)
+		g_atomic_int_inc(&pool->ref_count);
+	g_mutex_unlock(&_handle->packet_mutex);
+
+	*packet = pool ? __pool_get_packet(pool, mimetype, width, height) : NULL;
+
+	if (*packet == NULL) {
+		err = __get_media_format(_handle, mimetype, width, height, &fmt);
+		if (err != IMAGE_UTIL_ERROR_NONE) {
+			image_util_error("__get_media_format failed (%d)", err);
+			if (pool)
+				__pool_unref(pool);
+			return err;
+		}
+
+		/* the packet has its own reference of the format */
+		if (pool) {
+			err = __pool_create_packet(pool, fmt, mimetype, width, height, packet);
+		} else {
+			err = media_packet_create_alloc(fmt, NULL, NULL, packet);
+			if (err != MEDIA_PACKET_ERROR_NONE) {
+				image_util_error("media_packet_create_alloc failed (%d)", err);
+				err = IMAGE_UTIL_ERROR_INVALID_OPERATION;
+			}
+		}
+		media_format_unref(fmt);
+	}
+
+	if (pool)
+		__pool_unref(pool);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "Making packet failed (%d)", err);
+
+	err = media_packet_get_buffer_size(*packet, packet_size);
 	if (err != MEDIA_PACKET_ERROR_NONE) {
 		image_util_error("media_packet_get_buffer_size failed (%d)", err);
 		media_packet_destroy(*packet);
 		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
 	}
 
-	err = media_packet_get_buffer_data_ptr(*packet, &packet_ptr);
+	err = media_packet_get_buffer_data_ptr(*packet, packet_ptr);
 	if (err != MEDIA_PACKET_ERROR_NONE) {
 		image_util_error("media_packet_get_buffer_data_ptr failed");
 		media_packet_destroy(*packet);
 		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
 	}
 
-	if (packet_ptr == NULL || packet_size == 0) {
-		image_util_error("media_packet creation failed (%p, %" PRIu64 ")", packet_ptr, packet_size);
-		media_packet_destroy(*packet);
-		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
-	}
-	image_util_debug("Success - media_packet is created (%p, %" PRIu64 ")", packet_ptr, packet_size);
+	if (*packet_ptr == NULL || *packet_size == 0) {
+		image_util_error("media_packet creation failed (%p, %" PRIu64 ")", *packet_ptr, *packet_size);
+		media_packet_destroy(*packet);
+		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
+	}
+	image_util_debug("Success - media_packet is created (%p, %" PRIu64 ")", *packet_ptr, *packet_size);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static int __create_packet(transformation_s *_handle, mm_util_color_format_e format, unsigned long width, unsigned long height, void *buffer, size_t buffer_size, media_packet_h *packet)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	void *packet_ptr = NULL;
+	uint64_t packet_size = 0;
+	size_t size = 0;
+
+	err = __alloc_packet(_handle, __image_format_to_mimetype(format), (unsigned int)width, (unsigned int)height, packet, &packet_ptr, &packet_size);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__alloc_packet failed (%d)", err);
+
+	if ((uint64_t)buffer_size < packet_size) {
+		size = (size_t)buffer_size;
+	} else {
+		size = (size_t)packet_size;
+	}
+
+	image_util_debug("Size: result(%u) media_packet(%" PRIu64 ") copied(%zu)", buffer_size, packet_size, size);
+	memcpy(packet_ptr, buffer, size);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static int __get_dst_buffer(media_format_mimetype_e dst_mimetype, unsigned long width, unsigned long height, media_packet_h packet, void **packet_ptr, uint64_t *packet_size)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	media_format_h fmt = NULL;
+	media_format_mimetype_e mimetype = 0;
+	int packet_width = 0, packet_height = 0;
+
+	err = media_packet_get_format(packet, &fmt);
+	image_util_retvm_if((err != MEDIA_PACKET_ERROR_NONE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "media_packet_get_format failed (%d)", err);
+
+	err = media_format_get_video_info(fmt, &mimetype, &packet_width, &packet_height, NULL, NULL);
+	media_format_unref(fmt);
+	image_util_retvm_if((err != MEDIA_FORMAT_ERROR_NONE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "media_format_get_video_info failed (%d)", err);
+
+	image_util_retvm_if((mimetype != dst_mimetype), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Mismatched dst format (%d)", mimetype);
+	image_util_retvm_if(((unsigned long)packet_width != width) || ((unsigned long)packet_height != height), IMAGE_UTIL_ERROR_INVALID_PARAMETER,
+		"Mismatched dst resolution: result(%lu x %lu) media_packet(%d x %d)", width, height, packet_width, packet_height);
+
+	err = media_packet_get_buffer_size(packet, packet_size);
+	image_util_retvm_if((err != MEDIA_PACKET_ERROR_NONE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "media_packet_get_buffer_size failed (%d)", err);
+
+	err = media_packet_get_buffer_data_ptr(packet, packet_ptr);
+	image_util_retvm_if((err != MEDIA_PACKET_ERROR_NONE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "media_packet_get_buffer_data_ptr failed (%d)", err);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static int __copy_to_packet(mm_util_color_format_e format, unsigned long width, unsigned long height, void *buffer, size_t buffer_size, media_packet_h packet)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	void *packet_ptr = NULL;
+	uint64_t packet_size = 0;
+
+	err = __get_dst_buffer(__image_format_to_mimetype(format), width, height, packet, &packet_ptr, &packet_size);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__get_dst_buffer failed (%d)", err);
+
+	image_util_retvm_if((packet_ptr == NULL) || (packet_size < (uint64_t)buffer_size), IMAGE_UTIL_ERROR_INVALID_PARAMETER,
+		"Too small dst packet: result(%zu) media_packet(%" PRIu64 ")", buffer_size, packet_size);
+
+	memcpy(packet_ptr, buffer, buffer_size);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static void __replace_buffer(unsigned char **buffer, unsigned char *res_buffer, const unsigned char *src)
+{
+	if (*buffer != src)
+		IMAGE_UTIL_SAFE_FREE(*buffer);
+	*buffer = res_buffer;
+}
+
+static image_util_colorspace_e __image_format_to_colorspace(mm_util_color_format_e format)
+{
+	unsigned int idx = 0;
+
+	for (idx = 0; idx < NUM_OF_COLORSPACE; idx++) {
+		if (TYPECAST_COLOR(idx) == (int)format)
+			return (image_util_colorspace_e)idx;
+	}
+
+	return _NOT_SUPPORTED_COLORSPACE;
+}
+
+static int __get_packet_planes(media_packet_h packet, image_util_colorspace_e colorspace, unsigned int width, unsigned int height, transform_image_s *image)
+{
+	int err = MEDIA_PACKET_ERROR_NONE;
+	uint32_t num_planes = 0;
+	uint32_t idx = 0;
+	void *plane_ptr = NULL;
+	int stride = 0;
+	unsigned char *planes[TRANSFORM_MAX_PLANES] = { NULL, };
+	unsigned int strides[TRANSFORM_MAX_PLANES] = { 0, };
+
+	err = media_packet_get_number_of_video_planes(packet, &num_planes);
+	image_util_retvm_if((err != MEDIA_PACKET_ERROR_NONE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "media_packet_get_number_of_video_planes failed (%d)", err);
+	image_util_retvm_if((num_planes == 0 || num_planes > TRANSFORM_MAX_PLANES), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid number of planes (%u)", num_planes);
+
+	for (idx = 0; idx < num_planes; idx++) {
+		err = media_packet_get_video_plane_data_ptr(packet, (int)idx, &plane_ptr);
+		image_util_retvm_if((err != MEDIA_PACKET_ERROR_NONE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "media_packet_get_video_plane_data_ptr failed (%d)", err);
+
+		err = media_packet_get_video_stride_width(packet, (int)idx, &stride);
+		image_util_retvm_if((err != MEDIA_PACKET_ERROR_NONE || stride <= 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "media_packet_get_video_stride_width failed (%d)", err);
+
+		planes[idx] = (unsigned char *)plane_ptr;
+		strides[idx] = (unsigned int)stride;
+	}
+
+	return _transform_set_planes(image, colorspace, width, height, planes, strides, num_planes);
+}
+
+/* uses the planes and the strides of the packet, or the tightly packed buffer if the packet doesn't have them */
+static int __get_packet_transform_image(media_packet_h packet, image_util_colorspace_e colorspace, unsigned int width, unsigned int height, void *ptr, size_t size, transform_image_s *image)
+{
+	if (__get_packet_planes(packet, colorspace, width, height, image) == IMAGE_UTIL_ERROR_NONE)
+		return IMAGE_UTIL_ERROR_NONE;
+
+	image_util_debug("Use the packet as a tightly packed buffer");
+
+	return _transform_set_image(image, colorspace, width, height, ptr, size);
+}
+
+/* the queued job which is canceled or expired stops at the next row or tile */
+static int __check_job(void *user_data)
+{
+	image_util_cb_s *_util_cb = (image_util_cb_s *) user_data;
+
+	if (_util_cb == NULL)
+		return IMAGE_UTIL_ERROR_NONE;
+
+	if (g_atomic_int_get(&_util_cb->canceled))
+		return IMAGE_UTIL_ERROR_CANCELED;
+
+	if (_util_cb->deadline != 0 && g_get_monotonic_time() >= _util_cb->deadline)
+		return IMAGE_UTIL_ERROR_TIMED_OUT;
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static int __get_crop_area(transformation_s *_handle, unsigned int width, unsigned int height, transform_area_s *area)
+{
+	area->x = 0;
+	area->y = 0;
+	area->width = width;
+	area->height = height;
+
+	if (!_handle->set_crop)
+		return IMAGE_UTIL_ERROR_NONE;
+
+	image_util_retvm_if((_handle->end_x > width || _handle->end_y > height), IMAGE_UTIL_ERROR_INVALID_PARAMETER,
+		"Crop area is out of the image (%u x %u)", width, height);
+
+	area->x = _handle->start_x;
+	area->y = _handle->start_y;
+	area->width = _handle->end_x - _handle->start_x;
+	area->height = _handle->end_y - _handle->start_y;
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static void __get_transform_options(transformation_s *_handle, transform_options_s *options)
+{
+	memset(options, 0, sizeof(transform_options_s));
+	options->dither = _handle->dither;
+	options->filter = _handle->resize_filter;
+	options->max_threads = _handle->max_threads;
+	options->priority = _handle->priority;
+}
+
+/* renders @src_image into the result packet of @width x @height, the packet is made if *@dst is NULL, @area and @rotation are of @plan if it is given */
+static int __transform_to_packet(transformation_s *_handle, image_util_cb_s *_util_cb, transform_plan_s *plan, const transform_image_s *src_image, const transform_area_s *area, image_util_rotation_e rotation,
+	image_util_colorspace_e colorspace, unsigned int width, unsigned int height, media_packet_h *dst, transform_image_s *dst_image)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	media_format_mimetype_e mimetype = __image_format_to_mimetype(TYPECAST_COLOR(colorspace));
+	media_packet_h packet = *dst;
+	void *packet_ptr = NULL;
+	uint64_t packet_size = 0;
+	transform_options_s options;
+
+	image_util_retvm_if(((int)mimetype < 0), IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT, "Not supported dst format (%d)", colorspace);
+
+	if (packet != NULL)
+		err = __get_dst_buffer(mimetype, width, height, packet, &packet_ptr, &packet_size);
+	else
+		err = __alloc_packet(_handle, mimetype, width, height, &packet, &packet_ptr, &packet_size);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "making result packet failed (%d)", err);
+
+	__get_transform_options(_handle, &options);
+
+	err = __get_packet_transform_image(packet, colorspace, width, height, packet_ptr, (size_t)packet_size, dst_image);
+	if (err == IMAGE_UTIL_ERROR_NONE && plan)
+		err = _transform_plan_run(plan, src_image, dst_image, _util_cb ? __check_job : NULL, _util_cb);
+	else if (err == IMAGE_UTIL_ERROR_NONE)
+		err = _transform_run(src_image, area, rotation, &options, dst_image, _util_cb ? __check_job : NULL, _util_cb);
+
+	if (err != IMAGE_UTIL_ERROR_NONE) {
+		image_util_error("Error - Run transform (%d)", err);
+		if (*dst == NULL)
+			media_packet_destroy(packet);
+		return err;
+	}
+
+	*dst = packet;
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* the crop area, the rotation, the colorspace and the size of the result for the source of @width x @height */
+static int __get_transform_geometry(transformation_s *_handle, image_util_colorspace_e colorspace, unsigned int width, unsigned int height,
+	transform_area_s *area, image_util_rotation_e *rotation, image_util_colorspace_e *dst_colorspace, unsigned int *res_w, unsigned int *res_h)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+
+	*dst_colorspace = _handle->set_convert ? _handle->colorspace : colorspace;
+	*rotation = _handle->set_rotate ? _handle->rotation : IMAGE_UTIL_ROTATION_NONE;
+
+	err = __get_crop_area(_handle, width, height, area);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__get_crop_area failed (%d)", err);
+
+	if (_handle->set_resize)
+		_transform_get_output_size(_handle->width, _handle->height, *rotation, res_w, res_h);
+	else
+		_transform_get_output_size(area->width, area->height, *rotation, res_w, res_h);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* runs crop, resize, converting and rotation at once into the result packet without intermediate buffers */
+static int __transform_in_one_pass(transformation_s *_handle, image_util_cb_s *_util_cb, media_packet_h src, image_util_colorspace_e colorspace, unsigned int width, unsigned int height, void *ptr, size_t size, media_packet_h *dst)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	image_util_colorspace_e dst_colorspace = 0;
+	image_util_rotation_e rotation = IMAGE_UTIL_ROTATION_NONE;
+	transform_area_s area;
+	transform_image_s src_image, dst_image;
+	unsigned int res_w = 0, res_h = 0;
+
+	err = __get_transform_geometry(_handle, colorspace, width, height, &area, &rotation, &dst_colorspace, &res_w, &res_h);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__get_transform_geometry failed (%d)", err);
+
+	err = __get_packet_transform_image(src, colorspace, width, height, ptr, size, &src_image);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "Invalid source image (%d)", err);
+
+	return __transform_to_packet(_handle, _util_cb, NULL, &src_image, &area, rotation, dst_colorspace, res_w, res_h, dst, &dst_image);
+}
+
+static void __clear_prepared_plan(transformation_s *_handle)
+{
+	transform_plan_s *plan = NULL;
+
+	g_mutex_lock(&_handle->plan_mutex);
+	plan = _handle->prepared.plan;
+	memset(&_handle->prepared, 0, sizeof(prepared_plan_s));
+	g_mutex_unlock(&_handle->plan_mutex);
+
+	_transform_plan_unref(plan);
+}
+
+/* gets the prepared plan with a reference if it is made for the source of @mimetype and @width x @height */
+static bool __get_prepared_plan(transformation_s *_handle, media_format_mimetype_e mimetype, unsigned int width, unsigned int height, prepared_plan_s *prepared)
+{
+	bool found = false;
+
+	g_mutex_lock(&_handle->plan_mutex);
+	if (_handle->prepared.plan && _handle->prepared.mimetype == mimetype && _handle->prepared.width == width && _handle->prepared.height == height) {
+		*prepared = _handle->prepared;
+		_transform_plan_ref(prepared->plan);
+		found = true;
+	}
+	g_mutex_unlock(&_handle->plan_mutex);
+
+	return found;
+}
+
+/* the formats, the geometry and the filters are already in the plan */
+static int __transform_with_plan(transformation_s *_handle, image_util_cb_s *_util_cb, const prepared_plan_s *prepared, media_packet_h src, void *ptr, size_t size, media_packet_h *dst)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transform_image_s src_image, dst_image;
+
+	err = __get_packet_transform_image(src, prepared->colorspace, prepared->width, prepared->height, ptr, size, &src_image);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "Invalid source image (%d)", err);
+
+	return __transform_to_packet(_handle, _util_cb, prepared->plan, &src_image, NULL, IMAGE_UTIL_ROTATION_NONE,
+		prepared->dst_colorspace, prepared->dst_width, prepared->dst_height, dst, &dst_image);
+}
+
+int _image_util_transform_sync(transformation_s *_handle, image_util_cb_s *_util_cb, media_packet_h src, media_packet_h *dst)
+{
+	int err = MM_UTIL_ERROR_NONE;
+	media_format_mimetype_e mimetype = 0;
+	int width = 0, height = 0;
+	uint64_t size = 0;
+	void *ptr = NULL;
+	mm_util_color_format_e format = 0;
+	image_util_colorspace_e colorspace = 0;
+	unsigned char *buffer = NULL;
+	unsigned char *res_buffer = NULL;
+	unsigned int res_w = 0;
+	unsigned int res_h = 0;
+	size_t res_buffer_size = 0;
+	prepared_plan_s prepared;
+
+	err = __get_packet_image(src, &mimetype, &width, &height, &ptr, &size);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__get_packet_image failed (%d)", err);
+	image_util_retvm_if(((width == 0) || (height == 0)), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source packet");
+
+	if (__get_prepared_plan(_handle, mimetype, (unsigned int)width, (unsigned int)height, &prepared)) {
+		err = __transform_with_plan(_handle, _util_cb, &prepared, src, ptr, (size_t)size, dst);
+		_transform_plan_unref(prepared.plan);
+		return err;
+	}
+
+	format = __mimetype_to_image_format(mimetype);
+	image_util_retvm_if(((int)format < 0), IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT, "Not supported format (%d)", mimetype);
+
+	colorspace = __image_format_to_colorspace(format);
+	if (_transform_get_format(colorspace) && (!_handle->set_convert || _transform_get_format(_handle->colorspace)))
+		return __transform_in_one_pass(_handle, _util_cb, src, colorspace, (unsigned int)width, (unsigned int)height, ptr, (size_t)size, dst);
+
+	/* the formats which the one pass transform doesn't support, like NV12 tiled */
+	image_util_retvm_if(((size == 0) || (ptr == NULL)), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source packet");
+
+	buffer = (unsigned char *)ptr;
+	res_w = (unsigned int)width;
+	res_h = (unsigned int)height;
+	res_buffer_size = (size_t)size;
+
+	/* the order of running is crop, resolution, colorspace converting, rotation */
+	if (_handle->set_crop) {
+		err = mm_util_crop_image(buffer, res_w, res_h, format, _handle->start_x, _handle->start_y,
+				_handle->end_x - _handle->start_x, _handle->end_y - _handle->start_y, &res_buffer, &res_w, &res_h, &res_buffer_size);
+		if (err != MM_UTIL_ERROR_NONE)
+			goto ERROR;
+		__replace_buffer(&buffer, res_buffer, ptr);
+	}
+
+	err = __check_job(_util_cb);
+	if (err != IMAGE_UTIL_ERROR_NONE)
+		goto STOPPED;
+
+	if (_handle->set_resize) {
+		err = mm_util_resize_image(buffer, res_w, res_h, format, _handle->width, _handle->height, &res_buffer, &res_w, &res_h, &res_buffer_size);
+		if (err != MM_UTIL_ERROR_NONE)
+			goto ERROR;
+		__replace_buffer(&buffer, res_buffer, ptr);
+	}
+
+	err = __check_job(_util_cb);
+	if (err != IMAGE_UTIL_ERROR_NONE)
+		goto STOPPED;
+
+	if (_handle->set_convert && (TYPECAST_COLOR(_handle->colorspace) != (int)format)) {
+		err = mm_util_convert_colorspace(buffer, res_w, res_h, format, TYPECAST_COLOR(_handle->colorspace), &res_buffer, &res_w, &res_h, &res_buffer_size);
+		if (err != MM_UTIL_ERROR_NONE)
+			goto ERROR;
+		__replace_buffer(&buffer, res_buffer, ptr);
+		format = TYPECAST_COLOR(_handle->colorspace);
+	}
+
+	err = __check_job(_util_cb);
+	if (err != IMAGE_UTIL_ERROR_NONE)
+		goto STOPPED;
+
+	if (_handle->set_rotate && (_handle->rotation != IMAGE_UTIL_ROTATION_NONE)) {
+		err = mm_util_rotate_image(buffer, res_w, res_h, format, _handle->rotation, &res_buffer, &res_w, &res_h, &res_buffer_size);
+		if (err != MM_UTIL_ERROR_NONE)
+			goto ERROR;
+		__replace_buffer(&buffer, res_buffer, ptr);
+	}
+
+	if (*dst != NULL)
+		err = __copy_to_packet(format, res_w, res_h, buffer, res_buffer_size, *dst);
+	else
+		err = __create_packet(_handle, format, res_w, res_h, buffer, res_buffer_size, dst);
+	__replace_buffer(&buffer, NULL, ptr);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "making result packet failed (%d)", err);
+
+	return IMAGE_UTIL_ERROR_NONE;
+
+ERROR:
+	image_util_error("Error - Run transform (%d)", err);
+	__replace_buffer(&buffer, NULL, ptr);
+
+	return _image_error_capi(ERR_TYPE_TRANSFORM, err);
+
+STOPPED:
+	image_util_error("Stop transform (%d)", err);
+	__replace_buffer(&buffer, NULL, ptr);
+
+	return err;
+}
+
+typedef struct {
+	transformation_s *handle;
+	image_util_cb_s *job;
+} transform_batch_s;
+
+static int _image_util_transform_batch_item(void *data, unsigned int idx, void **local)
+{
+	transform_batch_s *batch = (transform_batch_s *) data;
+
+	batch->job->errors[idx] = _image_util_transform_sync(batch->handle, batch->job, batch->job->srcs[idx], &batch->job->dsts[idx]);
+	if (batch->job->errors[idx] != IMAGE_UTIL_ERROR_NONE)
+		image_util_error("[%u] _image_util_transform_sync failed (%d)", idx, batch->job->errors[idx]);
+
+	return batch->job->errors[idx];
+}
+
+static void _image_util_transform_batch(transformation_s *_handle, image_util_cb_s *_util_cb)
+{
+	transform_batch_s batch = { _handle, _util_cb };
+
+	/* the items share the workers of the scheduler with the bands of each item, the errors are of the items */
+	_image_util_scheduler_run_parallel(_handle->priority, _util_cb->num, _handle->max_threads, _image_util_transform_batch_item, NULL, &batch, NULL);
+
+	_util_cb->batch_completed_cb(_util_cb->dsts, _util_cb->errors, _util_cb->num, _util_cb->user_data);
+}
+
+/* the results which are already made and cover @width x @height, the smallest one is the cheapest source */
+static int __find_cascade_source(const image_util_cb_s *_util_cb, const transform_image_s *images, const unsigned int *order, unsigned int done, unsigned int width, unsigned int height)
+{
+	int found = -1;
+	unsigned int k = 0, i = 0;
+
+	for (k = 0; k < done; k++) {
+		i = order[k];
+		if (_util_cb->errors[i] != IMAGE_UTIL_ERROR_NONE || images[i].width < width || images[i].height < height)
+			continue;
+		if (found < 0 || (uint64_t)images[i].width * images[i].height < (uint64_t)images[found].width * images[found].height)
+			found = (int)i;
+	}
+
+	return found;
+}
+
+static int __transform_multi_resolution(transformation_s *_handle, image_util_cb_s *_util_cb, transform_image_s *images, unsigned int *order)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	media_format_mimetype_e mimetype = 0;
+	int width = 0, height = 0;
+	uint64_t size = 0;
+	void *ptr = NULL;
+	image_util_colorspace_e colorspace = 0;
+	image_util_colorspace_e dst_colorspace = 0;
+	image_util_rotation_e rotation = _handle->set_rotate ? _handle->rotation : IMAGE_UTIL_ROTATION_NONE;
+	transform_area_s area;
+	transform_image_s src_image;
+	unsigned int res_w = 0, res_h = 0;
+	unsigned int k = 0, i = 0, tmp = 0;
+	int source = 0;
+
+	err = __get_packet_image(_util_cb->src, &mimetype, &width, &height, &ptr, &size);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__get_packet_image failed (%d)", err);
+	image_util_retvm_if(((width == 0) || (height == 0)), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source packet");
+
+	colorspace = __image_format_to_colorspace(__mimetype_to_image_format(mimetype));
+	dst_colorspace = _handle->set_convert ? _handle->colorspace : colorspace;
+	image_util_retvm_if((!_transform_get_format(colorspace) || !_transform_get_format(dst_colorspace)), IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT, "Not supported format (%d)", mimetype);
+
+	err = __get_crop_area(_handle, (unsigned int)width, (unsigned int)height, &area);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__get_crop_area failed (%d)", err);
+
+	err = __get_packet_transform_image(_util_cb->src, colorspace, (unsigned int)width, (unsigned int)height, ptr, (size_t)size, &src_image);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "Invalid source image (%d)", err);
+
+	/* from the largest resolution, so the smaller ones can be made from the larger results */
+	for (k = 0; k < _util_cb->num; k++) {
+		order[k] = k;
+		for (i = k; i > 0; i--) {
+			if ((uint64_t)_util_cb->widths[order[i]] * _util_cb->heights[order[i]] <= (uint64_t)_util_cb->widths[order[i - 1]] * _util_cb->heights[order[i - 1]])
+				break;
+			tmp = order[i];
+			order[i] = order[i - 1];
+			order[i - 1] = tmp;
+		}
+	}
+
+	for (k = 0; k < _util_cb->num; k++) {
+		i = order[k];
+		_transform_get_output_size(_util_cb->widths[i], _util_cb->heights[i], rotation, &res_w, &res_h);
+
+		/* the larger result is already cropped, converted and rotated */
+		source = __find_cascade_source(_util_cb, images, order, k, res_w, res_h);
+		if (source >= 0 && (uint64_t)images[source].width * images[source].height < (uint64_t)area.width * area.height)
+			err = __transform_to_packet(_handle, _util_cb, NULL, &images[source], NULL, IMAGE_UTIL_ROTATION_NONE, dst_colorspace, res_w, res_h, &_util_cb->dsts[i], &images[i]);
+		else
+			err = __transform_to_packet(_handle, _util_cb, NULL, &src_image, &area, rotation, dst_colorspace, res_w, res_h, &_util_cb->dsts[i], &images[i]);
+
+		_util_cb->errors[i] = err;
+		if (err != IMAGE_UTIL_ERROR_NONE)
+			image_util_error("[%u] %u x %u failed (%d)", i, _util_cb->widths[i], _util_cb->heights[i], err);
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static void _image_util_transform_multi_resolution(transformation_s *_handle, image_util_cb_s *_util_cb)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transform_image_s *images = NULL;
+	unsigned int *order = NULL;
+	unsigned int idx = 0;
+
+	images = (transform_image_s *) calloc(_util_cb->num, sizeof(transform_image_s));
+	order = (unsigned int *) calloc(_util_cb->num, sizeof(unsigned int));
+	if (images == NULL || order == NULL) {
+		image_util_error("Memory allocation failed");
+		err = IMAGE_UTIL_ERROR_OUT_OF_MEMORY;
+	} else {
+		err = __transform_multi_resolution(_handle, _util_cb, images, order);
+	}
+
+	if (err != IMAGE_UTIL_ERROR_NONE) {
+		for (idx = 0; idx < _util_cb->num; idx++)
+			_util_cb->errors[idx] = err;
+	}
+
+	IMAGE_UTIL_SAFE_FREE(images);
+	IMAGE_UTIL_SAFE_FREE(order);
+
+	_util_cb->batch_completed_cb(_util_cb->dsts, _util_cb->errors, _util_cb->num, _util_cb->user_data);
+}
+
+static void _image_util_transform_destroy_job(image_util_cb_s *_util_cb)
+{
+	IMAGE_UTIL_SAFE_FREE(_util_cb->srcs);
+	IMAGE_UTIL_SAFE_FREE(_util_cb->dsts);
+	IMAGE_UTIL_SAFE_FREE(_util_cb->errors);
+	IMAGE_UTIL_SAFE_FREE(_util_cb->widths);
+	IMAGE_UTIL_SAFE_FREE(_util_cb->heights);
+	IMAGE_UTIL_SAFE_FREE(_util_cb);
+}
+
+static void _image_util_transform_drop_job(image_util_cb_s *_util_cb, int error)
+{
+	unsigned int idx = 0;
+
+	if (_util_cb->batch_completed_cb) {
+		for (idx = 0; idx < _util_cb->num; idx++)
+			_util_cb->errors[idx] = error;
+		_util_cb->batch_completed_cb(_util_cb->dsts, _util_cb->errors, _util_cb->num, _util_cb->user_data);
+	} else {
+		_util_cb->completed_cb(NULL, error, _util_cb->user_data);
+	}
+}
+
+static void _image_util_transform_run_job(transformation_s *_handle, image_util_cb_s *_util_cb)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	media_packet_h dst = NULL;
+
+	/* the canceled or expired job is completed without running */
+	err = __check_job(_util_cb);
+	if (err != IMAGE_UTIL_ERROR_NONE) {
+		image_util_error("Drop the job (%d)", err);
+		_image_util_transform_drop_job(_util_cb, err);
+	} else if (_util_cb->widths) {
+		_image_util_transform_multi_resolution(_handle, _util_cb);
+	} else if (_util_cb->batch_completed_cb) {
+		_image_util_transform_batch(_handle, _util_cb);
+	} else {
+		dst = _util_cb->dst;
+		err = _image_util_transform_sync(_handle, _util_cb, _util_cb->src, &dst);
+		if (err != IMAGE_UTIL_ERROR_NONE) {
+			image_util_error("_image_util_transform_sync failed (%d)", err);
+			_util_cb->completed_cb(NULL, err, _util_cb->user_data);
+		} else {
+			_util_cb->completed_cb(&dst, err, _util_cb->user_data);
+		}
+	}
+}
+
+/* runs the head job and yields to the scheduler, so the works of the higher priority go first */
+static void _image_util_transform_work(void *data)
+{
+	transformation_s *_handle = (transformation_s *) data;
+	image_util_cb_s *_util_cb = NULL;
+
+	image_util_fenter();
 
-	if ((uint64_t)buffer_size < packet_size) {
-		size = (size_t)buffer_size;
-	} else {
-		size = (size_t)packet_size;
-	}
+	g_mutex_lock(&_handle->job_mutex);
+	while (TRUE) {
+		_util_cb = (image_util_cb_s *) g_queue_peek_head(&_handle->job_queue);
+		_handle->worker = g_thread_self();
+		g_mutex_unlock(&_handle->job_mutex);
 
-	image_util_debug("Size: result(%u) media_packet(%" PRIu64 ") copied(%zu)", buffer_size, packet_size, size);
-	memcpy(packet_ptr, buffer, size);
+		_image_util_transform_run_job(_handle, _util_cb);
 
-	image_util_debug("_image_util_image_to_packet succeed");
+		g_mutex_lock(&_handle->job_mutex);
+		g_queue_pop_head(&_handle->job_queue);
+		_image_util_transform_destroy_job(_util_cb);
+		_handle->worker = NULL;
 
-	return IMAGE_UTIL_ERROR_NONE;
+		if (g_queue_is_empty(&_handle->job_queue)) {
+			_handle->running = false;
+			g_cond_broadcast(&_handle->job_cond);
+			break;
+		}
+
+		if (_image_util_scheduler_push(_handle->priority, _image_util_transform_work, _handle) == IMAGE_UTIL_ERROR_NONE)
+			break;
+	}
+	g_mutex_unlock(&_handle->job_mutex);
+
+	image_util_fleave();
 }
 
-static void _image_util_transform_completed_cb(mm_util_color_image_h raw_image, int error, void *user_data)
+static int _image_util_transform_push_job(transformation_s *_handle, image_util_cb_s *_util_cb)
 {
 	int err = IMAGE_UTIL_ERROR_NONE;
-	image_util_cb_s *_util_cb = (image_util_cb_s *) user_data;
-	media_packet_h packet = NULL;
 
-	if ((_util_cb != NULL) && (_util_cb->completed_cb != NULL)) {
-		err = _image_util_image_to_packet(raw_image, &packet);
-		if (err != MM_UTIL_ERROR_NONE) {
-			image_util_error("_image_util_image_to_packet failed (%d)", err);
-			_util_cb->completed_cb(NULL, err, _util_cb->user_data);
-		} else {
-			_util_cb->completed_cb(&packet, _image_error_capi(ERR_TYPE_TRANSFORM, error), _util_cb->user_data);
+	g_mutex_lock(&_handle->job_mutex);
+
+	if (g_queue_get_length(&_handle->job_queue) >= _handle->queue_depth) {
+		g_mutex_unlock(&_handle->job_mutex);
+		image_util_error("The queue is full (%u)", _handle->queue_depth);
+		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
+	}
+
+	if (!_handle->running) {
+		err = _image_util_scheduler_push(_handle->priority, _image_util_transform_work, _handle);
+		if (err != IMAGE_UTIL_ERROR_NONE) {
+			g_mutex_unlock(&_handle->job_mutex);
+			image_util_error("_image_util_scheduler_push failed (%d)", err);
+			return err;
 		}
+		_handle->running = true;
 	}
 
-	return;
+	if (_handle->timeout != 0)
+		_util_cb->deadline = g_get_monotonic_time() + (gint64)_handle->timeout * G_TIME_SPAN_MILLISECOND;
+
+	g_queue_push_tail(&_handle->job_queue, _util_cb);
+
+	g_mutex_unlock(&_handle->job_mutex);
+
+	return IMAGE_UTIL_ERROR_NONE;
 }
 
 static int _image_util_create_transform_handle(transformation_s * handle)
@@ -258,8 +1031,10 @@ int image_util_transform_create(transformation_h * handle)
 	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "OUT_OF_MEMORY");
 
 	_handle->colorspace = _NOT_SUPPORTED_COLORSPACE;
-	_handle->_util_cb = NULL;
 	_handle->image_h = NULL;
+	_handle->queue_depth = TRANSFORM_DEFAULT_QUEUE_DEPTH;
+	_handle->priority = IMAGE_UTIL_PRIORITY_NORMAL;
+	_handle->resize_filter = IMAGE_UTIL_RESIZE_FILTER_BILINEAR;
 	_handle->set_convert = false;
 	_handle->set_resize = false;
 	_handle->set_rotate = false;
@@ -272,6 +1047,12 @@ int image_util_transform_create(transformation_h * handle)
 		return _image_error_capi(ERR_TYPE_TRANSFORM, err);
 	}
 
+	g_mutex_init(&_handle->job_mutex);
+	g_cond_init(&_handle->job_cond);
+	g_queue_init(&_handle->job_queue);
+	g_mutex_init(&_handle->packet_mutex);
+	g_mutex_init(&_handle->plan_mutex);
+
 	*handle = (transformation_h) _handle;
 
 	return IMAGE_UTIL_ERROR_NONE;
@@ -308,6 +1089,21 @@ int image_util_transform_set_colorspace(transformation_h handle, image_util_colo
 
 	_handle->colorspace = colorspace;
 	_handle->set_convert = true;
+	__clear_prepared_plan(_handle);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_set_dither(transformation_h handle, bool dither)
+{
+	transformation_s *_handle = (transformation_s *) handle;
+
+	image_util_debug("Set dither [%d]", dither);
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+
+	_handle->dither = dither;
+	__clear_prepared_plan(_handle);
 
 	return IMAGE_UTIL_ERROR_NONE;
 }
@@ -320,7 +1116,6 @@ int image_util_transform_set_resolution(transformation_h handle, unsigned int wi
 	image_util_debug("Set resize_info w[%d] h[%d]", width, height);
 
 	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
-	image_util_retvm_if((_handle->set_crop), IMAGE_UTIL_ERROR_INVALID_OPERATION, "Crop and Resize can't do at the same time");
 	image_util_retvm_if((_image_util_check_resolution(width, height) == false), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid resolution");
 
 	err = mm_util_set_resolution(_handle->image_h, width, height);
@@ -329,6 +1124,36 @@ int image_util_transform_set_resolution(transformation_h handle, unsigned int wi
 	_handle->width = width;
 	_handle->height = height;
 	_handle->set_resize = true;
+	__clear_prepared_plan(_handle);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_set_resize_filter(transformation_h handle, image_util_resize_filter_e filter)
+{
+	transformation_s *_handle = (transformation_s *) handle;
+
+	image_util_debug("Set resize_filter [%d]", filter);
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+	image_util_retvm_if((filter < IMAGE_UTIL_RESIZE_FILTER_NEAREST || filter > IMAGE_UTIL_RESIZE_FILTER_LANCZOS3), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid filter");
+
+	_handle->resize_filter = filter;
+	__clear_prepared_plan(_handle);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_set_max_threads(transformation_h handle, unsigned int max_threads)
+{
+	transformation_s *_handle = (transformation_s *) handle;
+
+	image_util_debug("Set max_threads [%u]", max_threads);
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+
+	_handle->max_threads = max_threads;
+	__clear_prepared_plan(_handle);
 
 	return IMAGE_UTIL_ERROR_NONE;
 }
@@ -347,6 +1172,7 @@ int image_util_transform_set_rotation(transformation_h handle, image_util_rotati
 
 	_handle->rotation = rotation;
 	_handle->set_rotate = true;
+	__clear_prepared_plan(_handle);
 
 	return IMAGE_UTIL_ERROR_NONE;
 }
@@ -359,7 +1185,6 @@ int image_util_transform_set_crop_area(transformation_h handle, unsigned int sta
 	int dest_height;
 
 	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
-	image_util_retvm_if((_handle->set_resize), IMAGE_UTIL_ERROR_INVALID_OPERATION, "Crop and Resize can't do at the same time");
 
 	dest_width = end_x - start_x;
 	dest_height = end_y - start_y;
@@ -375,6 +1200,128 @@ int image_util_transform_set_crop_area(transformation_h handle, unsigned int sta
 	_handle->end_x = end_x;
 	_handle->end_y = end_y;
 	_handle->set_crop = true;
+	__clear_prepared_plan(_handle);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_prepare(transformation_h handle, image_util_colorspace_e colorspace, unsigned int width, unsigned int height)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transformation_s *_handle = (transformation_s *) handle;
+	media_format_mimetype_e mimetype = 0;
+	prepared_plan_s prepared;
+	transform_area_s area;
+	image_util_rotation_e rotation = IMAGE_UTIL_ROTATION_NONE;
+	transform_plan_s *old_plan = NULL;
+	transform_options_s options;
+
+	image_util_debug("Prepare colorspace [%d] w[%u] h[%u]", colorspace, width, height);
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+	image_util_retvm_if((colorspace < 0 || colorspace >= NUM_OF_COLORSPACE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid colorspace");
+	image_util_retvm_if((_image_util_check_resolution(width, height) == false), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid resolution");
+
+	mimetype = __image_format_to_mimetype(TYPECAST_COLOR(colorspace));
+	image_util_retvm_if(((int)mimetype < 0), IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT, "Not supported format (%d)", colorspace);
+
+	memset(&prepared, 0, sizeof(prepared_plan_s));
+	prepared.mimetype = mimetype;
+	prepared.width = width;
+	prepared.height = height;
+	prepared.colorspace = colorspace;
+
+	err = __get_transform_geometry(_handle, colorspace, width, height, &area, &rotation, &prepared.dst_colorspace, &prepared.dst_width, &prepared.dst_height);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__get_transform_geometry failed (%d)", err);
+
+	__get_transform_options(_handle, &options);
+	err = _transform_plan_create(colorspace, width, height, &area, rotation, prepared.dst_colorspace, prepared.dst_width, prepared.dst_height, &options, &prepared.plan);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "_transform_plan_create failed (%d)", err);
+
+	g_mutex_lock(&_handle->plan_mutex);
+	old_plan = _handle->prepared.plan;
+	_handle->prepared = prepared;
+	g_mutex_unlock(&_handle->plan_mutex);
+
+	_transform_plan_unref(old_plan);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_set_queue_depth(transformation_h handle, unsigned int depth)
+{
+	transformation_s *_handle = (transformation_s *) handle;
+
+	image_util_debug("Set queue_depth [%u]", depth);
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+	image_util_retvm_if((depth == 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid queue depth");
+
+	g_mutex_lock(&_handle->job_mutex);
+	_handle->queue_depth = depth;
+	g_mutex_unlock(&_handle->job_mutex);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_set_priority(transformation_h handle, image_util_priority_e priority)
+{
+	transformation_s *_handle = (transformation_s *) handle;
+
+	image_util_debug("Set priority [%d]", priority);
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+	image_util_retvm_if((priority < IMAGE_UTIL_PRIORITY_LOW || priority > IMAGE_UTIL_PRIORITY_HIGH), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid priority");
+
+	g_mutex_lock(&_handle->job_mutex);
+	_handle->priority = priority;
+	g_mutex_unlock(&_handle->job_mutex);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_set_deadline(transformation_h handle, unsigned int timeout)
+{
+	transformation_s *_handle = (transformation_s *) handle;
+
+	image_util_debug("Set deadline [%u ms]", timeout);
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+
+	g_mutex_lock(&_handle->job_mutex);
+	_handle->timeout = timeout;
+	g_mutex_unlock(&_handle->job_mutex);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_set_packet_pool_size(transformation_h handle, unsigned int size)
+{
+	transformation_s *_handle = (transformation_s *) handle;
+	packet_pool_s *pool = NULL;
+	packet_pool_s *old_pool = NULL;
+
+	image_util_debug("Set packet_pool_size [%u]", size);
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+
+	if (size > 0) {
+		pool = (packet_pool_s *) calloc(1, sizeof(packet_pool_s));
+		image_util_retvm_if((pool == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Memory allocation failed");
+
+		pool->ref_count = 1;
+		pool->size = size;
+		g_mutex_init(&pool->mutex);
+		g_queue_init(&pool->packets);
+	}
+
+	g_mutex_lock(&_handle->packet_mutex);
+	old_pool = _handle->pool;
+	_handle->pool = pool;
+	g_mutex_unlock(&_handle->packet_mutex);
+
+	if (old_pool)
+		__pool_close(old_pool);
 
 	return IMAGE_UTIL_ERROR_NONE;
 }
@@ -457,42 +1404,283 @@ int image_util_transform_get_crop_area(transformation_h handle, unsigned int *st
 	return IMAGE_UTIL_ERROR_NONE;
 }
 
+static int _image_util_transform_run(transformation_s *_handle, media_packet_h src, media_packet_h dst, image_util_transform_completed_cb completed_cb, void *user_data)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	image_util_cb_s *_util_cb = NULL;
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+	image_util_retvm_if((completed_cb == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid callback");
+	image_util_retvm_if((src == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source");
+	image_util_retvm_if((!_handle->set_convert && !_handle->set_resize && !_handle->set_rotate && !_handle->set_crop), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid transform");
+
+	_util_cb = (image_util_cb_s *) calloc(1, sizeof(image_util_cb_s));
+	image_util_retvm_if((_util_cb == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Memory allocation failed");
+
+	_util_cb->user_data = user_data;
+	_util_cb->src = src;
+	_util_cb->dst = dst;
+	_util_cb->completed_cb = completed_cb;
+
+	err = _image_util_transform_push_job(_handle, _util_cb);
+	if (err != IMAGE_UTIL_ERROR_NONE) {
+		image_util_error("Error - Run transform (%d)", err);
+		IMAGE_UTIL_SAFE_FREE(_util_cb);
+		return err;
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
 int image_util_transform_run(transformation_h handle, media_packet_h src, image_util_transform_completed_cb completed_cb, void *user_data)
 {
-	int err = MM_UTIL_ERROR_NONE;
+	image_util_fenter();
+
+	return _image_util_transform_run((transformation_s *) handle, src, NULL, completed_cb, user_data);
+}
+
+int image_util_transform_run_to(transformation_h handle, media_packet_h src, media_packet_h dst, image_util_transform_completed_cb completed_cb, void *user_data)
+{
+	image_util_fenter();
+
+	image_util_retvm_if((dst == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid destination");
+
+	return _image_util_transform_run((transformation_s *) handle, src, dst, completed_cb, user_data);
+}
+
+int image_util_transform_run_batch(transformation_h handle, media_packet_h *srcs, unsigned int num, image_util_transform_batch_completed_cb completed_cb, void *user_data)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
 	transformation_s *_handle = (transformation_s *) handle;
+	image_util_cb_s *_util_cb = NULL;
+	unsigned int idx = 0;
 
 	image_util_fenter();
 
 	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
 	image_util_retvm_if((completed_cb == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid callback");
-	image_util_retvm_if((src == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source");
+	image_util_retvm_if((srcs == NULL || num == 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source");
 	image_util_retvm_if((!_handle->set_convert && !_handle->set_resize && !_handle->set_rotate && !_handle->set_crop), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid transform");
 
-	mm_util_color_image_h color_image = NULL;
+	for (idx = 0; idx < num; idx++)
+		image_util_retvm_if((srcs[idx] == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source [%u]", idx);
 
-	err = _image_util_packet_to_image(src, &color_image);
-	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "_image_util_packet_to_image failed");
+	_util_cb = (image_util_cb_s *) calloc(1, sizeof(image_util_cb_s));
+	image_util_retvm_if((_util_cb == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Memory allocation failed");
 
-	_handle->_util_cb = (image_util_cb_s *) calloc(1, sizeof(image_util_cb_s));
-	if (_handle->_util_cb == NULL) {
+	_util_cb->srcs = (media_packet_h *) calloc(num, sizeof(media_packet_h));
+	_util_cb->dsts = (media_packet_h *) calloc(num, sizeof(media_packet_h));
+	_util_cb->errors = (int *) calloc(num, sizeof(int));
+	if (_util_cb->srcs == NULL || _util_cb->dsts == NULL || _util_cb->errors == NULL) {
 		image_util_error("Memory allocation failed");
-		mm_util_destroy_color_image(color_image);
+		_image_util_transform_destroy_job(_util_cb);
 		return IMAGE_UTIL_ERROR_OUT_OF_MEMORY;
 	}
-	_handle->_util_cb->user_data = user_data;
-	_handle->_util_cb->completed_cb = completed_cb;
 
-	err = mm_util_transform(_handle->image_h, color_image, (mm_util_completed_callback) _image_util_transform_completed_cb, (void *)_handle->_util_cb);
-	if (err != MM_UTIL_ERROR_NONE) {
-		image_util_error("Error - Run transform (%d)", err);
-		mm_util_destroy_color_image(color_image);
-		return _image_error_capi(ERR_TYPE_TRANSFORM, err);
+	memcpy(_util_cb->srcs, srcs, num * sizeof(media_packet_h));
+	_util_cb->num = num;
+	_util_cb->user_data = user_data;
+	_util_cb->batch_completed_cb = completed_cb;
+
+	err = _image_util_transform_push_job(_handle, _util_cb);
+	if (err != IMAGE_UTIL_ERROR_NONE) {
+		image_util_error("Error - Run batch transform (%d)", err);
+		_image_util_transform_destroy_job(_util_cb);
+		return err;
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_run_multi_resolution(transformation_h handle, media_packet_h src, const unsigned int *widths, const unsigned int *heights, unsigned int num, image_util_transform_batch_completed_cb completed_cb, void *user_data)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transformation_s *_handle = (transformation_s *) handle;
+	image_util_cb_s *_util_cb = NULL;
+	unsigned int idx = 0;
+
+	image_util_fenter();
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+	image_util_retvm_if((completed_cb == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid callback");
+	image_util_retvm_if((src == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source");
+	image_util_retvm_if((widths == NULL || heights == NULL || num == 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid resolutions");
+
+	for (idx = 0; idx < num; idx++)
+		image_util_retvm_if((_image_util_check_resolution(widths[idx], heights[idx]) == false), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid resolution [%u]", idx);
+
+	_util_cb = (image_util_cb_s *) calloc(1, sizeof(image_util_cb_s));
+	image_util_retvm_if((_util_cb == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Memory allocation failed");
+
+	_util_cb->widths = (unsigned int *) calloc(num, sizeof(unsigned int));
+	_util_cb->heights = (unsigned int *) calloc(num, sizeof(unsigned int));
+	_util_cb->dsts = (media_packet_h *) calloc(num, sizeof(media_packet_h));
+	_util_cb->errors = (int *) calloc(num, sizeof(int));
+	if (_util_cb->widths == NULL || _util_cb->heights == NULL || _util_cb->dsts == NULL || _util_cb->errors == NULL) {
+		image_util_error("Memory allocation failed");
+		_image_util_transform_destroy_job(_util_cb);
+		return IMAGE_UTIL_ERROR_OUT_OF_MEMORY;
+	}
+
+	memcpy(_util_cb->widths, widths, num * sizeof(unsigned int));
+	memcpy(_util_cb->heights, heights, num * sizeof(unsigned int));
+	_util_cb->src = src;
+	_util_cb->num = num;
+	_util_cb->user_data = user_data;
+	_util_cb->batch_completed_cb = completed_cb;
+
+	err = _image_util_transform_push_job(_handle, _util_cb);
+	if (err != IMAGE_UTIL_ERROR_NONE) {
+		image_util_error("Error - Run multi resolution transform (%d)", err);
+		_image_util_transform_destroy_job(_util_cb);
+		return err;
 	}
 
 	return IMAGE_UTIL_ERROR_NONE;
 }
 
+int image_util_transform_run_sync(transformation_h handle, media_packet_h src, media_packet_h *dst)
+{
+	transformation_s *_handle = (transformation_s *) handle;
+
+	image_util_fenter();
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+	image_util_retvm_if((src == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source");
+	image_util_retvm_if((dst == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid destination");
+	image_util_retvm_if((!_handle->set_convert && !_handle->set_resize && !_handle->set_rotate && !_handle->set_crop), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid transform");
+
+	*dst = NULL;
+
+	return _image_util_transform_sync(_handle, NULL, src, dst);
+}
+
+typedef struct {
+	image_util_transform_read_strip_cb read_cb;
+	image_util_transform_write_strip_cb write_cb;
+	void *user_data;
+} strips_cb_s;
+
+static int __read_strip(unsigned int y, unsigned int rows, unsigned char *buffer, size_t size, void *user_data)
+{
+	strips_cb_s *_strips_cb = (strips_cb_s *) user_data;
+
+	return _strips_cb->read_cb(y, rows, buffer, (unsigned int)size, _strips_cb->user_data) ? IMAGE_UTIL_ERROR_NONE : IMAGE_UTIL_ERROR_CANCELED;
+}
+
+static int __write_strip(unsigned int y, unsigned int rows, const unsigned char *buffer, size_t size, void *user_data)
+{
+	strips_cb_s *_strips_cb = (strips_cb_s *) user_data;
+
+	return _strips_cb->write_cb(y, rows, buffer, (unsigned int)size, _strips_cb->user_data) ? IMAGE_UTIL_ERROR_NONE : IMAGE_UTIL_ERROR_CANCELED;
+}
+
+int image_util_transform_run_strips(transformation_h handle, image_util_colorspace_e colorspace, unsigned int width, unsigned int height,
+	image_util_transform_read_strip_cb read_cb, image_util_transform_write_strip_cb write_cb, void *user_data)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transformation_s *_handle = (transformation_s *) handle;
+	image_util_colorspace_e dst_colorspace = 0;
+	image_util_rotation_e rotation = IMAGE_UTIL_ROTATION_NONE;
+	transform_area_s area;
+	transform_options_s options;
+	transform_plan_s *plan = NULL;
+	unsigned int res_w = 0, res_h = 0;
+	strips_cb_s strips_cb = { read_cb, write_cb, user_data };
+
+	image_util_fenter();
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+	image_util_retvm_if((read_cb == NULL || write_cb == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid callback");
+	image_util_retvm_if((_image_util_check_resolution(width, height) == false), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid resolution");
+	image_util_retvm_if((!_handle->set_convert && !_handle->set_resize && !_handle->set_rotate && !_handle->set_crop), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid transform");
+
+	err = __get_transform_geometry(_handle, colorspace, width, height, &area, &rotation, &dst_colorspace, &res_w, &res_h);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__get_transform_geometry failed (%d)", err);
+
+	__get_transform_options(_handle, &options);
+
+	err = _transform_plan_create(colorspace, width, height, &area, rotation, dst_colorspace, res_w, res_h, &options, &plan);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "_transform_plan_create failed (%d)", err);
+
+	err = _transform_plan_run_strips(plan, __read_strip, __write_strip, &strips_cb, NULL, NULL);
+
+	_transform_plan_unref(plan);
+
+	return err;
+}
+
+int image_util_transform_run_roi(transformation_h handle, media_packet_h src, unsigned int x, unsigned int y, unsigned int width, unsigned int height,
+	unsigned int tile_width, unsigned int tile_height, media_packet_h *dst)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transformation_s *_handle = (transformation_s *) handle;
+	media_format_mimetype_e mimetype = 0;
+	int src_width = 0, src_height = 0;
+	uint64_t size = 0;
+	void *ptr = NULL;
+	mm_util_color_format_e format = 0;
+	image_util_colorspace_e colorspace = 0, dst_colorspace = 0;
+	image_util_rotation_e rotation = IMAGE_UTIL_ROTATION_NONE;
+	transform_area_s roi = { x, y, width, height };
+	transform_options_s options;
+	transform_plan_s *plan = NULL;
+	transform_image_s src_image, dst_image;
+
+	image_util_fenter();
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+	image_util_retvm_if((src == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source");
+	image_util_retvm_if((dst == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid destination");
+	image_util_retvm_if((_image_util_check_resolution(width, height) == false), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid region");
+	image_util_retvm_if((_image_util_check_resolution(tile_width, tile_height) == false), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid tile resolution");
+
+	err = __get_packet_image(src, &mimetype, &src_width, &src_height, &ptr, &size);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__get_packet_image failed (%d)", err);
+	image_util_retvm_if((x >= (unsigned int)src_width || width > (unsigned int)src_width - x || y >= (unsigned int)src_height || height > (unsigned int)src_height - y),
+		IMAGE_UTIL_ERROR_INVALID_PARAMETER,
+		"Region is out of the image (%d x %d)", src_width, src_height);
+
+	format = __mimetype_to_image_format(mimetype);
+	image_util_retvm_if(((int)format < 0), IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT, "Not supported format (%d)", mimetype);
+
+	colorspace = __image_format_to_colorspace(format);
+	dst_colorspace = _handle->set_convert ? _handle->colorspace : colorspace;
+	rotation = _handle->set_rotate ? _handle->rotation : IMAGE_UTIL_ROTATION_NONE;
+
+	err = __get_packet_transform_image(src, colorspace, (unsigned int)src_width, (unsigned int)src_height, ptr, (size_t)size, &src_image);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "Invalid source image (%d)", err);
+
+	__get_transform_options(_handle, &options);
+
+	err = _transform_plan_create_roi(colorspace, (unsigned int)src_width, (unsigned int)src_height, &roi, rotation, dst_colorspace, tile_width, tile_height, &options, &plan);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "_transform_plan_create_roi failed (%d)", err);
+
+	*dst = NULL;
+	err = __transform_to_packet(_handle, NULL, plan, &src_image, NULL, IMAGE_UTIL_ROTATION_NONE, dst_colorspace, tile_width, tile_height, dst, &dst_image);
+
+	_transform_plan_unref(plan);
+
+	return err;
+}
+
+int image_util_transform_cancel(transformation_h handle)
+{
+	transformation_s *_handle = (transformation_s *) handle;
+	GList *iter = NULL;
+
+	image_util_fenter();
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+
+	g_mutex_lock(&_handle->job_mutex);
+	for (iter = _handle->job_queue.head; iter; iter = iter->next)
+		g_atomic_int_set(&((image_util_cb_s *) iter->data)->canceled, 1);
+	g_mutex_unlock(&_handle->job_mutex);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
 int image_util_transform_destroy(transformation_h handle)
 {
 	int err = MM_UTIL_ERROR_NONE;
@@ -502,9 +1690,30 @@ int image_util_transform_destroy(transformation_h handle)
 
 	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
 
+	g_mutex_lock(&_handle->job_mutex);
+	if (_handle->worker == g_thread_self()) {
+		g_mutex_unlock(&_handle->job_mutex);
+		image_util_error("Can't destroy in the callback");
+		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
+	}
+
+	/* pending jobs are done before destroying, so every callback is called once */
+	while (_handle->running)
+		g_cond_wait(&_handle->job_cond, &_handle->job_mutex);
+	g_mutex_unlock(&_handle->job_mutex);
+
+	g_cond_clear(&_handle->job_cond);
+	g_mutex_clear(&_handle->job_mutex);
+
+	if (_handle->pool)
+		__pool_close(_handle->pool);
+	__clear_media_formats(_handle);
+	g_mutex_clear(&_handle->packet_mutex);
+	__clear_prepared_plan(_handle);
+	g_mutex_clear(&_handle->plan_mutex);
+
 	err = mm_util_destroy(_handle->image_h);
 
-	IMAGE_UTIL_SAFE_FREE(_handle->_util_cb);
 	IMAGE_UTIL_SAFE_FREE(_handle);
 
 	return _image_error_capi(ERR_TYPE_TRANSFORM, err);
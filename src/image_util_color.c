@@ -0,0 +1,711 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <image_util_private.h>
+#include <image_util_transform_private.h>
+
+#define CHROMA_SIZE(x, shift)	(((x) + (1 << (shift)) - 1) >> (shift))
+
+static inline unsigned char __clip(int value)
+{
+	return (unsigned char)((value < 0) ? 0 : ((value > 255) ? 255 : value));
+}
+
+/* BT.601, limited range */
+static inline void __yuv_to_rgb(int y, int u, int v, unsigned char *r, unsigned char *g, unsigned char *b)
+{
+	int c = 298 * (y - 16) + 128;
+	int d = u - 128;
+	int e = v - 128;
+
+	*r = __clip((c + 409 * e) >> 8);
+	*g = __clip((c - 100 * d - 208 * e) >> 8);
+	*b = __clip((c + 516 * d) >> 8);
+}
+
+static inline void __rgb_to_yuv(int r, int g, int b, unsigned char *y, unsigned char *u, unsigned char *v)
+{
+	*y = __clip(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+	*u = __clip(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+	*v = __clip(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+void _transform_convert_row(unsigned char *row, unsigned int width, transform_domain_e from, transform_domain_e to)
+{
+	unsigned int i = 0;
+
+	if (from == to)
+		return;
+
+	if (to == TRANSFORM_DOMAIN_RGB) {
+		for (i = 0; i < width; i++, row += TRANSFORM_PIXEL_SIZE)
+			__yuv_to_rgb(row[0], row[1], row[2], &row[0], &row[1], &row[2]);
+	} else {
+		for (i = 0; i < width; i++, row += TRANSFORM_PIXEL_SIZE)
+			__rgb_to_yuv(row[0], row[1], row[2], &row[0], &row[1], &row[2]);
+	}
+}
+
+/* the offsets of R, G, B and A in the pixel of each transform_order_e */
+static const unsigned int _transform_order_tbl[][4] = {
+	{ 0, 1, 2, 3 },		/* TRANSFORM_ORDER_RGBA */
+	{ 2, 1, 0, 3 },		/* TRANSFORM_ORDER_BGRA */
+	{ 1, 2, 3, 0 },		/* TRANSFORM_ORDER_ARGB */
+};
+
+/* the reference of the SIMD kernels in image_util_simd.c, which also converts the rest of their rows */
+void _transform_yuv_to_rgb_row(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int uv_step, unsigned char *out, unsigned int width, transform_order_e order)
+{
+	const unsigned int *idx = _transform_order_tbl[order];
+	unsigned int i = 0, c = 0;
+
+	for (i = 0; i < width; i++, out += TRANSFORM_PIXEL_SIZE) {
+		c = (i >> 1) * uv_step;
+		__yuv_to_rgb(py[i], pu[c], pv[c], &out[idx[0]], &out[idx[1]], &out[idx[2]]);
+		out[idx[3]] = 0xff;
+	}
+}
+
+/* the reference of the SIMD kernels in image_util_simd.c, the chroma is the rounded average of the chroma of the 2x2 pixels as __pack_yuv_planar() does */
+void _transform_rgb_to_yuv_row(const unsigned char *row0, const unsigned char *row1, unsigned char *py0, unsigned char *py1, unsigned char *pu, unsigned char *pv, unsigned int uv_step, unsigned int width, transform_order_e order)
+{
+	const unsigned int *idx = _transform_order_tbl[order];
+	const unsigned char *rows[2] = { row0, row1 };
+	unsigned char *py[2] = { py0, py1 };
+	const unsigned char *p = NULL;
+	unsigned char u = 0, v = 0;
+	unsigned int i = 0, j = 0, k = 0, n = 0, su = 0, sv = 0;
+
+	for (i = 0; i < width; i += 2) {
+		n = 0;
+		su = 0;
+		sv = 0;
+
+		for (k = 0; k < 2 && rows[k]; k++) {
+			for (j = i; j < i + 2 && j < width; j++, n++) {
+				p = rows[k] + (size_t)j * TRANSFORM_PIXEL_SIZE;
+				__rgb_to_yuv(p[idx[0]], p[idx[1]], p[idx[2]], &py[k][j], &u, &v);
+				su += u;
+				sv += v;
+			}
+		}
+
+		/* n is 1, 2 or 4 */
+		n >>= 1;
+		pu[(i >> 1) * uv_step] = (unsigned char)((su + ((1 << n) >> 1)) >> n);
+		pv[(i >> 1) * uv_step] = (unsigned char)((sv + ((1 << n) >> 1)) >> n);
+	}
+}
+
+/* the references of the SIMD kernels of transform_yuv_kernels_s in image_util_simd.c */
+void _transform_split_uv(const unsigned char *uv, unsigned char *u, unsigned char *v, unsigned int count)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < count; i++) {
+		u[i] = uv[i * 2];
+		v[i] = uv[i * 2 + 1];
+	}
+}
+
+void _transform_merge_uv(const unsigned char *u, const unsigned char *v, unsigned char *uv, unsigned int count)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < count; i++) {
+		uv[i * 2] = u[i];
+		uv[i * 2 + 1] = v[i];
+	}
+}
+
+void _transform_split_packed(const unsigned char *in, unsigned int y_idx, unsigned char *py, unsigned char *pu, unsigned char *pv, unsigned int width)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < width; i++)
+		py[i] = in[(i >> 1) * 4 + y_idx + (i & 1) * 2];
+
+	for (i = 0; i < CHROMA_SIZE(width, 1); i++) {
+		pu[i] = in[i * 4 + (y_idx ^ 1)];
+		pv[i] = in[i * 4 + (y_idx ^ 1) + 2];
+	}
+}
+
+/* the second Y of the last macro pixel of the odd @width is the first one as __pack_yuv_packed_row() does */
+void _transform_merge_packed(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int y_idx, unsigned char *out, unsigned int width)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < CHROMA_SIZE(width, 1); i++, out += 4) {
+		out[y_idx] = py[i * 2];
+		out[y_idx + 2] = (i * 2 + 1 < width) ? py[i * 2 + 1] : py[i * 2];
+		out[y_idx ^ 1] = pu[i];
+		out[(y_idx ^ 1) + 2] = pv[i];
+	}
+}
+
+void _transform_average(const unsigned char *a, const unsigned char *b, unsigned char *out, unsigned int count)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < count; i++)
+		out[i] = (unsigned char)((a[i] + b[i] + 1) >> 1);
+}
+
+/* averages the chroma of the pixels (2 * @i, 2 * @i + 1) of @row0 and @row1 */
+static inline void __average_uv(const unsigned char *row0, const unsigned char *row1, unsigned int i, unsigned int width, unsigned char *u, unsigned char *v)
+{
+	const unsigned char *p = row0 + i * 2 * TRANSFORM_PIXEL_SIZE;
+	unsigned int pair = (i * 2 + 1 < width) ? 1 : 0;
+	unsigned int shift = pair;
+	unsigned int su = p[1] + (pair ? p[5] : 0);
+	unsigned int sv = p[2] + (pair ? p[6] : 0);
+
+	if (row1) {
+		p = row1 + i * 2 * TRANSFORM_PIXEL_SIZE;
+		su += p[1] + (pair ? p[5] : 0);
+		sv += p[2] + (pair ? p[6] : 0);
+		shift++;
+	}
+
+	*u = (unsigned char)((su + ((1 << shift) >> 1)) >> shift);
+	*v = (unsigned char)((sv + ((1 << shift) >> 1)) >> shift);
+}
+
+static void __unpack_yuv_planar(const transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, unsigned char *row, unsigned int v_shift)
+{
+	const unsigned char *py = image->planes[0] + (size_t)y * image->strides[0] + x;
+	const unsigned char *pu = image->planes[1] + (size_t)(y >> v_shift) * image->strides[1];
+	const unsigned char *pv = image->planes[2] + (size_t)(y >> v_shift) * image->strides[2];
+	unsigned int i = 0;
+
+	for (i = 0; i < width; i++, row += TRANSFORM_PIXEL_SIZE) {
+		row[0] = py[i];
+		row[1] = pu[(x + i) >> 1];
+		row[2] = pv[(x + i) >> 1];
+		row[3] = 0xff;
+	}
+}
+
+static void __pack_yuv_planar(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1, unsigned int v_shift)
+{
+	unsigned char *py = image->planes[0] + (size_t)y * image->strides[0] + x;
+	unsigned char *pu = image->planes[1] + (size_t)(y >> v_shift) * image->strides[1] + (x >> 1);
+	unsigned char *pv = image->planes[2] + (size_t)(y >> v_shift) * image->strides[2] + (x >> 1);
+	unsigned int i = 0;
+
+	for (i = 0; i < width; i++)
+		py[i] = row0[i * TRANSFORM_PIXEL_SIZE];
+
+	if (row1) {
+		py += image->strides[0];
+		for (i = 0; i < width; i++)
+			py[i] = row1[i * TRANSFORM_PIXEL_SIZE];
+	}
+
+	if (v_shift) {
+		for (i = 0; i < CHROMA_SIZE(width, 1); i++)
+			__average_uv(row0, row1, i, width, &pu[i], &pv[i]);
+		return;
+	}
+
+	for (i = 0; i < CHROMA_SIZE(width, 1); i++)
+		__average_uv(row0, NULL, i, width, &pu[i], &pv[i]);
+
+	if (row1) {
+		pu += image->strides[1];
+		pv += image->strides[2];
+		for (i = 0; i < CHROMA_SIZE(width, 1); i++)
+			__average_uv(row1, NULL, i, width, &pu[i], &pv[i]);
+	}
+}
+
+static void __unpack_yuv_semi_planar(const transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, unsigned char *row, unsigned int v_shift, unsigned int u_idx)
+{
+	const unsigned char *py = image->planes[0] + (size_t)y * image->strides[0] + x;
+	const unsigned char *puv = image->planes[1] + (size_t)(y >> v_shift) * image->strides[1];
+	unsigned int i = 0;
+
+	for (i = 0; i < width; i++, row += TRANSFORM_PIXEL_SIZE) {
+		row[0] = py[i];
+		row[1] = puv[((x + i) >> 1) * 2 + u_idx];
+		row[2] = puv[((x + i) >> 1) * 2 + (u_idx ^ 1)];
+		row[3] = 0xff;
+	}
+}
+
+static void __pack_yuv_semi_planar(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1, unsigned int v_shift, unsigned int u_idx)
+{
+	unsigned char *py = image->planes[0] + (size_t)y * image->strides[0] + x;
+	unsigned char *puv = image->planes[1] + (size_t)(y >> v_shift) * image->strides[1] + (x >> 1) * 2;
+	unsigned int i = 0;
+
+	for (i = 0; i < width; i++)
+		py[i] = row0[i * TRANSFORM_PIXEL_SIZE];
+
+	if (row1) {
+		py += image->strides[0];
+		for (i = 0; i < width; i++)
+			py[i] = row1[i * TRANSFORM_PIXEL_SIZE];
+	}
+
+	if (v_shift) {
+		for (i = 0; i < CHROMA_SIZE(width, 1); i++)
+			__average_uv(row0, row1, i, width, &puv[i * 2 + u_idx], &puv[i * 2 + (u_idx ^ 1)]);
+		return;
+	}
+
+	for (i = 0; i < CHROMA_SIZE(width, 1); i++)
+		__average_uv(row0, NULL, i, width, &puv[i * 2 + u_idx], &puv[i * 2 + (u_idx ^ 1)]);
+
+	if (row1) {
+		puv += image->strides[1];
+		for (i = 0; i < CHROMA_SIZE(width, 1); i++)
+			__average_uv(row1, NULL, i, width, &puv[i * 2 + u_idx], &puv[i * 2 + (u_idx ^ 1)]);
+	}
+}
+
+/* @y_idx is the offset of the first Y in the 4 bytes macro pixel, U and V follow the Ys */
+static void __unpack_yuv_packed(const transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, unsigned char *row, unsigned int y_idx)
+{
+	const unsigned char *p = image->planes[0] + (size_t)y * image->strides[0];
+	const unsigned char *m = NULL;
+	unsigned int i = 0;
+
+	for (i = 0; i < width; i++, row += TRANSFORM_PIXEL_SIZE) {
+		m = p + ((x + i) >> 1) * 4;
+		row[0] = m[y_idx + ((x + i) & 1) * 2];
+		row[1] = m[y_idx ^ 1];
+		row[2] = m[(y_idx ^ 1) + 2];
+		row[3] = 0xff;
+	}
+}
+
+static void __pack_yuv_packed_row(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row, unsigned int y_idx)
+{
+	unsigned char *p = image->planes[0] + (size_t)y * image->strides[0] + (x >> 1) * 4;
+	unsigned int i = 0;
+
+	for (i = 0; i < CHROMA_SIZE(width, 1); i++, p += 4) {
+		p[y_idx] = row[i * 2 * TRANSFORM_PIXEL_SIZE];
+		p[y_idx + 2] = (i * 2 + 1 < width) ? row[(i * 2 + 1) * TRANSFORM_PIXEL_SIZE] : p[y_idx];
+		__average_uv(row, NULL, i, width, &p[y_idx ^ 1], &p[(y_idx ^ 1) + 2]);
+	}
+}
+
+static void __pack_yuv_packed(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1, unsigned int y_idx)
+{
+	__pack_yuv_packed_row(image, x, y, width, row0, y_idx);
+	if (row1)
+		__pack_yuv_packed_row(image, x, y + 1, width, row1, y_idx);
+}
+
+/* @r, @g, @b and @a are the offsets of each channel in the pixel, @a is negative if there is no alpha */
+static void __unpack_rgb(const transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, unsigned char *row, unsigned int bpp, int r, int g, int b, int a)
+{
+	const unsigned char *p = image->planes[0] + (size_t)y * image->strides[0] + (size_t)x * bpp;
+	unsigned int i = 0;
+
+	for (i = 0; i < width; i++, p += bpp, row += TRANSFORM_PIXEL_SIZE) {
+		row[0] = p[r];
+		row[1] = p[g];
+		row[2] = p[b];
+		row[3] = (a < 0) ? 0xff : p[a];
+	}
+}
+
+static void __pack_rgb_row(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row, unsigned int bpp, int r, int g, int b, int a)
+{
+	unsigned char *p = image->planes[0] + (size_t)y * image->strides[0] + (size_t)x * bpp;
+	unsigned int i = 0;
+
+	for (i = 0; i < width; i++, p += bpp, row += TRANSFORM_PIXEL_SIZE) {
+		p[r] = row[0];
+		p[g] = row[1];
+		p[b] = row[2];
+		/* the X of the 4 bytes pixel without alpha is 0xff like the direct kernels write it */
+		if (a >= 0)
+			p[a] = row[3];
+		else if (bpp == 4)
+			p[6 - r - g - b] = 0xff;
+	}
+}
+
+static void __pack_rgb(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1, unsigned int bpp, int r, int g, int b, int a)
+{
+	__pack_rgb_row(image, x, y, width, row0, bpp, r, g, b, a);
+	if (row1)
+		__pack_rgb_row(image, x, y + 1, width, row1, bpp, r, g, b, a);
+}
+
+/* the 4x4 Bayer matrix, 0 to 15 */
+static const unsigned char _transform_dither_tbl[4][4] = {
+	{ 0, 8, 2, 10 },
+	{ 12, 4, 14, 6 },
+	{ 3, 11, 1, 9 },
+	{ 15, 7, 13, 5 },
+};
+
+const unsigned char *_transform_get_dither_row(unsigned int y)
+{
+	return _transform_dither_tbl[y & 3];
+}
+
+/* the reference of the SIMD kernels in image_util_simd.c, the 5 and 6 bits are expanded by repeating their high bits */
+void _transform_unpack_rgb565_row(const unsigned char *in, unsigned char *out, unsigned int width, transform_order_e order)
+{
+	const unsigned int *idx = _transform_order_tbl[order];
+	unsigned int i = 0;
+	unsigned int c = 0;
+
+	for (i = 0; i < width; i++, in += 2, out += TRANSFORM_PIXEL_SIZE) {
+		c = in[0] | (in[1] << 8);
+		out[idx[0]] = (unsigned char)(((c >> 11) << 3) | (c >> 13));
+		out[idx[1]] = (unsigned char)((((c >> 5) & 0x3f) << 2) | ((c >> 9) & 0x3));
+		out[idx[2]] = (unsigned char)(((c & 0x1f) << 3) | ((c >> 2) & 0x7));
+		out[idx[3]] = 0xff;
+	}
+}
+
+/*
+ * the reference of the SIMD kernels in image_util_simd.c, the channels are truncated or, with @dither,
+ * rounded by the threshold of the matrix as (value + threshold - (value >> 5)) >> 3, which never overflows
+ * and keeps the values which RGB565 can represent, so unpacking and packing again is lossless
+ */
+void _transform_pack_rgb565_row(const unsigned char *in, unsigned char *out, unsigned int width, transform_order_e order, const unsigned char *dither)
+{
+	const unsigned int *idx = _transform_order_tbl[order];
+	unsigned int i = 0;
+	unsigned int r = 0, g = 0, b = 0, d = 0;
+	unsigned int c = 0;
+
+	for (i = 0; i < width; i++, in += TRANSFORM_PIXEL_SIZE, out += 2) {
+		r = in[idx[0]];
+		g = in[idx[1]];
+		b = in[idx[2]];
+		if (dither) {
+			d = dither[i & 3];
+			r = r + (d >> 1) - (r >> 5);
+			g = g + (d >> 2) - (g >> 6);
+			b = b + (d >> 1) - (b >> 5);
+		}
+		c = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+		out[0] = (unsigned char)(c & 0xff);
+		out[1] = (unsigned char)(c >> 8);
+	}
+}
+
+static void __unpack_rgb565(const transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, unsigned char *row)
+{
+	_transform_unpack_rgb565_row(image->planes[0] + (size_t)y * image->strides[0] + (size_t)x * 2, row, width, TRANSFORM_ORDER_RGBA);
+}
+
+static void __pack_rgb565(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1)
+{
+	_transform_pack_rgb565_row(row0, image->planes[0] + (size_t)y * image->strides[0] + (size_t)x * 2, width, TRANSFORM_ORDER_RGBA, NULL);
+	if (row1)
+		_transform_pack_rgb565_row(row1, image->planes[0] + (size_t)(y + 1) * image->strides[0] + (size_t)x * 2, width, TRANSFORM_ORDER_RGBA, NULL);
+}
+
+/* the pack of RGB565 with the ordered dither of the lines of the destination, which replaces the pack of the format */
+void _transform_pack_rgb565_dither(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1)
+{
+	const unsigned char *rows[2] = { row0, row1 };
+	const unsigned char *tbl = NULL;
+	unsigned char dither[4];
+	unsigned int k = 0, i = 0;
+
+	for (k = 0; k < 2 && rows[k]; k++) {
+		/* the matrix starts from @x */
+		tbl = _transform_get_dither_row(y + k);
+		for (i = 0; i < 4; i++)
+			dither[i] = tbl[(x + i) & 3];
+
+		_transform_pack_rgb565_row(rows[k], image->planes[0] + (size_t)(y + k) * image->strides[0] + (size_t)x * 2, width, TRANSFORM_ORDER_RGBA, dither);
+	}
+}
+
+#define DEFINE_YUV_PLANAR(name, v_shift) \
+static void __unpack_##name(const transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, unsigned char *row) \
+{ \
+	__unpack_yuv_planar(image, x, y, width, row, v_shift); \
+} \
+static void __pack_##name(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1) \
+{ \
+	__pack_yuv_planar(image, x, y, width, row0, row1, v_shift); \
+}
+
+#define DEFINE_YUV_SEMI_PLANAR(name, v_shift, u_idx) \
+static void __unpack_##name(const transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, unsigned char *row) \
+{ \
+	__unpack_yuv_semi_planar(image, x, y, width, row, v_shift, u_idx); \
+} \
+static void __pack_##name(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1) \
+{ \
+	__pack_yuv_semi_planar(image, x, y, width, row0, row1, v_shift, u_idx); \
+}
+
+#define DEFINE_YUV_PACKED(name, y_idx) \
+static void __unpack_##name(const transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, unsigned char *row) \
+{ \
+	__unpack_yuv_packed(image, x, y, width, row, y_idx); \
+} \
+static void __pack_##name(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1) \
+{ \
+	__pack_yuv_packed(image, x, y, width, row0, row1, y_idx); \
+}
+
+#define DEFINE_RGB(name, bpp, r, g, b, a) \
+static void __unpack_##name(const transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, unsigned char *row) \
+{ \
+	__unpack_rgb(image, x, y, width, row, bpp, r, g, b, a); \
+} \
+static void __pack_##name(transform_image_s *image, unsigned int x, unsigned int y, unsigned int width, const unsigned char *row0, const unsigned char *row1) \
+{ \
+	__pack_rgb(image, x, y, width, row0, row1, bpp, r, g, b, a); \
+}
+
+DEFINE_YUV_PLANAR(yuv420, 1)
+DEFINE_YUV_PLANAR(yuv422, 0)
+DEFINE_YUV_SEMI_PLANAR(nv12, 1, 0)
+DEFINE_YUV_SEMI_PLANAR(nv21, 1, 1)
+DEFINE_YUV_SEMI_PLANAR(nv16, 0, 0)
+DEFINE_YUV_SEMI_PLANAR(nv61, 0, 1)
+DEFINE_YUV_PACKED(uyvy, 1)
+DEFINE_YUV_PACKED(yuyv, 0)
+DEFINE_RGB(rgb888, 3, 0, 1, 2, -1)
+DEFINE_RGB(argb8888, 4, 1, 2, 3, 0)
+DEFINE_RGB(bgra8888, 4, 2, 1, 0, 3)
+DEFINE_RGB(rgba8888, 4, 0, 1, 2, 3)
+DEFINE_RGB(bgrx8888, 4, 2, 1, 0, -1)
+
+/* the same layouts as DEFINE_RGB() above for the swizzles */
+typedef struct {
+	image_util_colorspace_e colorspace;
+	unsigned int bpp;
+	int offsets[4];		/* R, G, B and A, A is negative if there is no alpha */
+} transform_rgb_layout_s;
+
+static const transform_rgb_layout_s _transform_rgb_layout_tbl[] = {
+	{ IMAGE_UTIL_COLORSPACE_RGB888, 3, { 0, 1, 2, -1 } },
+	{ IMAGE_UTIL_COLORSPACE_ARGB8888, 4, { 1, 2, 3, 0 } },
+	{ IMAGE_UTIL_COLORSPACE_BGRA8888, 4, { 2, 1, 0, 3 } },
+	{ IMAGE_UTIL_COLORSPACE_RGBA8888, 4, { 0, 1, 2, 3 } },
+	{ IMAGE_UTIL_COLORSPACE_BGRX8888, 4, { 2, 1, 0, -1 } },
+};
+
+static const transform_rgb_layout_s *__get_rgb_layout(image_util_colorspace_e colorspace)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < sizeof(_transform_rgb_layout_tbl) / sizeof(_transform_rgb_layout_tbl[0]); i++) {
+		if (_transform_rgb_layout_tbl[i].colorspace == colorspace)
+			return &_transform_rgb_layout_tbl[i];
+	}
+
+	return NULL;
+}
+
+/* the missing alpha is 0xff as __unpack_rgb() makes it, and so is the X of BGRX */
+bool _transform_get_swizzle(image_util_colorspace_e from, image_util_colorspace_e to, transform_swizzle_s *swizzle)
+{
+	const transform_rgb_layout_s *in = __get_rgb_layout(from);
+	const transform_rgb_layout_s *out = __get_rgb_layout(to);
+	unsigned int c = 0;
+
+	if (!in || !out)
+		return false;
+
+	memset(swizzle, 0, sizeof(transform_swizzle_s));
+	swizzle->in_bpp = in->bpp;
+	swizzle->out_bpp = out->bpp;
+
+	/* BGRX has the byte for the alpha at 3 */
+	if (out->bpp == 4)
+		swizzle->map[3] = -1;
+
+	for (c = 0; c < 4; c++) {
+		if (out->offsets[c] >= 0)
+			swizzle->map[out->offsets[c]] = in->offsets[c];
+	}
+
+	return true;
+}
+
+/* the reference of the SIMD kernels in image_util_simd.c, the pixel is read at once for the same row */
+void _transform_swizzle_row(const unsigned char *in, unsigned char *out, unsigned int width, const transform_swizzle_s *swizzle)
+{
+	unsigned char pixel[4];
+	unsigned int i = 0, k = 0;
+
+	for (i = 0; i < width; i++, in += swizzle->in_bpp, out += swizzle->out_bpp) {
+		memcpy(pixel, in, swizzle->in_bpp);
+		for (k = 0; k < swizzle->out_bpp; k++)
+			out[k] = (swizzle->map[k] < 0) ? 0xff : pixel[swizzle->map[k]];
+	}
+}
+
+static const transform_format_s _transform_format_tbl[] = {
+	{ TRANSFORM_DOMAIN_YUV, 3, 1, 1, __unpack_yuv420, __pack_yuv420 },		/* IMAGE_UTIL_COLORSPACE_YV12 */
+	{ TRANSFORM_DOMAIN_YUV, 3, 1, 0, __unpack_yuv422, __pack_yuv422 },		/* IMAGE_UTIL_COLORSPACE_YUV422 */
+	{ TRANSFORM_DOMAIN_YUV, 3, 1, 1, __unpack_yuv420, __pack_yuv420 },		/* IMAGE_UTIL_COLORSPACE_I420 */
+	{ TRANSFORM_DOMAIN_YUV, 2, 1, 1, __unpack_nv12, __pack_nv12 },			/* IMAGE_UTIL_COLORSPACE_NV12 */
+	{ TRANSFORM_DOMAIN_YUV, 1, 1, 0, __unpack_uyvy, __pack_uyvy },			/* IMAGE_UTIL_COLORSPACE_UYVY */
+	{ TRANSFORM_DOMAIN_YUV, 1, 1, 0, __unpack_yuyv, __pack_yuyv },			/* IMAGE_UTIL_COLORSPACE_YUYV */
+	{ TRANSFORM_DOMAIN_RGB, 1, 0, 0, __unpack_rgb565, __pack_rgb565 },		/* IMAGE_UTIL_COLORSPACE_RGB565 */
+	{ TRANSFORM_DOMAIN_RGB, 1, 0, 0, __unpack_rgb888, __pack_rgb888 },		/* IMAGE_UTIL_COLORSPACE_RGB888 */
+	{ TRANSFORM_DOMAIN_RGB, 1, 0, 0, __unpack_argb8888, __pack_argb8888 },	/* IMAGE_UTIL_COLORSPACE_ARGB8888 */
+	{ TRANSFORM_DOMAIN_RGB, 1, 0, 0, __unpack_bgra8888, __pack_bgra8888 },	/* IMAGE_UTIL_COLORSPACE_BGRA8888 */
+	{ TRANSFORM_DOMAIN_RGB, 1, 0, 0, __unpack_rgba8888, __pack_rgba8888 },	/* IMAGE_UTIL_COLORSPACE_RGBA8888 */
+	{ TRANSFORM_DOMAIN_RGB, 1, 0, 0, __unpack_bgrx8888, __pack_bgrx8888 },	/* IMAGE_UTIL_COLORSPACE_BGRX8888 */
+	{ TRANSFORM_DOMAIN_YUV, 2, 1, 1, __unpack_nv21, __pack_nv21 },			/* IMAGE_UTIL_COLORSPACE_NV21 */
+	{ TRANSFORM_DOMAIN_YUV, 2, 1, 0, __unpack_nv16, __pack_nv16 },			/* IMAGE_UTIL_COLORSPACE_NV16 */
+	{ TRANSFORM_DOMAIN_YUV, 2, 1, 0, __unpack_nv61, __pack_nv61 },			/* IMAGE_UTIL_COLORSPACE_NV61 */
+};
+
+const transform_format_s *_transform_get_format(image_util_colorspace_e colorspace)
+{
+	if ((colorspace < 0) || ((unsigned int)colorspace >= sizeof(_transform_format_tbl) / sizeof(_transform_format_tbl[0])))
+		return NULL;
+
+	return &_transform_format_tbl[colorspace];
+}
+
+/* gets the plane sizes of the tightly packed image */
+static void __get_plane_layout(image_util_colorspace_e colorspace, unsigned int width, unsigned int height, unsigned int *strides, size_t *sizes)
+{
+	const transform_format_s *format = _transform_get_format(colorspace);
+	unsigned int chroma_height = CHROMA_SIZE(height, format->v_shift);
+
+	memset(sizes, 0, sizeof(size_t) * TRANSFORM_MAX_PLANES);
+
+	switch (colorspace) {
+	case IMAGE_UTIL_COLORSPACE_YV12:
+	case IMAGE_UTIL_COLORSPACE_I420:
+	case IMAGE_UTIL_COLORSPACE_YUV422:
+		strides[0] = width;
+		strides[1] = strides[2] = CHROMA_SIZE(width, 1);
+		sizes[1] = sizes[2] = (size_t)strides[1] * chroma_height;
+		break;
+	case IMAGE_UTIL_COLORSPACE_NV12:
+	case IMAGE_UTIL_COLORSPACE_NV21:
+	case IMAGE_UTIL_COLORSPACE_NV16:
+	case IMAGE_UTIL_COLORSPACE_NV61:
+		strides[0] = width;
+		strides[1] = CHROMA_SIZE(width, 1) * 2;
+		sizes[1] = (size_t)strides[1] * chroma_height;
+		break;
+	case IMAGE_UTIL_COLORSPACE_UYVY:
+	case IMAGE_UTIL_COLORSPACE_YUYV:
+		strides[0] = CHROMA_SIZE(width, 1) * 4;
+		break;
+	case IMAGE_UTIL_COLORSPACE_RGB565:
+		strides[0] = width * 2;
+		break;
+	case IMAGE_UTIL_COLORSPACE_RGB888:
+		strides[0] = width * 3;
+		break;
+	default:
+		strides[0] = width * 4;
+		break;
+	}
+
+	sizes[0] = (size_t)strides[0] * height;
+}
+
+size_t _transform_get_buffer_size(image_util_colorspace_e colorspace, unsigned int width, unsigned int height)
+{
+	unsigned int strides[TRANSFORM_MAX_PLANES] = { 0, };
+	size_t sizes[TRANSFORM_MAX_PLANES] = { 0, };
+
+	image_util_retvm_if((_transform_get_format(colorspace) == NULL), 0, "Invalid colorspace [%d]", colorspace);
+
+	__get_plane_layout(colorspace, width, height, strides, sizes);
+
+	return sizes[0] + sizes[1] + sizes[2];
+}
+
+int _transform_set_image(transform_image_s *image, image_util_colorspace_e colorspace, unsigned int width, unsigned int height, void *buffer, size_t size)
+{
+	unsigned int strides[TRANSFORM_MAX_PLANES] = { 0, };
+	size_t sizes[TRANSFORM_MAX_PLANES] = { 0, };
+	unsigned char *ptr = (unsigned char *)buffer;
+
+	image_util_retvm_if((image == NULL || buffer == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid parameter");
+	image_util_retvm_if((_transform_get_format(colorspace) == NULL), IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT, "Invalid colorspace [%d]", colorspace);
+	image_util_retvm_if((width == 0 || height == 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid resolution");
+
+	__get_plane_layout(colorspace, width, height, strides, sizes);
+	image_util_retvm_if((size < sizes[0] + sizes[1] + sizes[2]), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Too small buffer (%zu)", size);
+
+	memset(image, 0, sizeof(transform_image_s));
+	image->colorspace = colorspace;
+	image->width = width;
+	image->height = height;
+	memcpy(image->strides, strides, sizeof(strides));
+
+	image->planes[0] = ptr;
+	if (colorspace == IMAGE_UTIL_COLORSPACE_YV12) {
+		/* Y, V, U */
+		image->planes[2] = ptr + sizes[0];
+		image->planes[1] = ptr + sizes[0] + sizes[2];
+	} else {
+		image->planes[1] = (sizes[1] != 0) ? ptr + sizes[0] : NULL;
+		image->planes[2] = (sizes[2] != 0) ? ptr + sizes[0] + sizes[1] : NULL;
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int _transform_set_planes(transform_image_s *image, image_util_colorspace_e colorspace, unsigned int width, unsigned int height, unsigned char **planes, const unsigned int *strides, unsigned int num_planes)
+{
+	const transform_format_s *format = _transform_get_format(colorspace);
+	unsigned int min_strides[TRANSFORM_MAX_PLANES] = { 0, };
+	size_t sizes[TRANSFORM_MAX_PLANES] = { 0, };
+	unsigned int i = 0;
+
+	image_util_retvm_if((image == NULL || planes == NULL || strides == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid parameter");
+	image_util_retvm_if((format == NULL), IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT, "Invalid colorspace [%d]", colorspace);
+	image_util_retvm_if((width == 0 || height == 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid resolution");
+	image_util_retvm_if((num_planes != format->num_planes), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Mismatched number of planes (%u)", num_planes);
+
+	__get_plane_layout(colorspace, width, height, min_strides, sizes);
+
+	for (i = 0; i < num_planes; i++) {
+		image_util_retvm_if((planes[i] == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid plane [%u]", i);
+		image_util_retvm_if((strides[i] < min_strides[i]), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Too small stride [%u] (%u)", i, strides[i]);
+	}
+
+	memset(image, 0, sizeof(transform_image_s));
+	image->colorspace = colorspace;
+	image->width = width;
+	image->height = height;
+
+	for (i = 0; i < num_planes; i++) {
+		image->planes[i] = planes[i];
+		image->strides[i] = strides[i];
+	}
+
+	if (colorspace == IMAGE_UTIL_COLORSPACE_YV12) {
+		/* the planes are given in the memory order, Y, V, U */
+		image->planes[1] = planes[2];
+		image->strides[1] = strides[2];
+		image->planes[2] = planes[1];
+		image->strides[2] = strides[1];
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
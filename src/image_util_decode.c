@@ -120,6 +120,9 @@ int image_util_decode_create(image_util_decode_h * handle)
 	_handle->mode = MODE_DECODE;
 	_handle->image_type = _NOT_SUPPORTED_IMAGE_TYPE;
 	_handle->colorspace = IMAGE_UTIL_COLORSPACE_RGBA8888;
+	_handle->priority = IMAGE_UTIL_PRIORITY_NORMAL;
+	g_mutex_init(&_handle->async_mutex);
+	g_cond_init(&_handle->async_cond);
 
 	*handle = (image_util_decode_h) _handle;
 
@@ -379,18 +382,13 @@ int image_util_decode_run(image_util_decode_h handle, unsigned long *width, unsi
 	return err;
 }
 
-gpointer _image_util_decode_thread(gpointer data)
+static void _image_util_decode_work(void *data)
 {
 	decode_encode_s *_handle = (decode_encode_s *) data;
 	int err = IMAGE_UTIL_ERROR_NONE;
 
 	image_util_fenter();
 
-	if (!_handle) {
-		image_util_error("[ERROR] - handle");
-		return NULL;
-	}
-
 	err = _image_util_decode_internal(_handle);
 	if (err == IMAGE_UTIL_ERROR_NONE)
 		image_util_debug("Success - decode_internal");
@@ -404,22 +402,22 @@ gpointer _image_util_decode_thread(gpointer data)
 		image_util_error("No callback");
 	}
 
-	image_util_fleave();
+	g_mutex_lock(&_handle->async_mutex);
+	_handle->running = false;
+	g_cond_broadcast(&_handle->async_cond);
+	g_mutex_unlock(&_handle->async_mutex);
 
-	return NULL;
+	image_util_fleave();
 }
 
-static int _image_util_decode_create_thread(decode_encode_s * handle)
+int image_util_decode_set_priority(image_util_decode_h handle, image_util_priority_e priority)
 {
-	image_util_retvm_if((handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
-	image_util_retvm_if((handle->thread != NULL), IMAGE_UTIL_ERROR_INVALID_OPERATION, "A thread is alread running");
+	decode_encode_s *_handle = (decode_encode_s *) handle;
 
-	/*create threads */
-	handle->thread = g_thread_new("decode_thread", (GThreadFunc) _image_util_decode_thread, (gpointer) handle);
-	if (!handle->thread) {
-		image_util_error("ERROR - create thread");
-		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
-	}
+	IMAGE_UTIL_DECODE_HANDLE_CHECK(handle);
+	image_util_retvm_if((priority < IMAGE_UTIL_PRIORITY_LOW || priority > IMAGE_UTIL_PRIORITY_HIGH), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid priority");
+
+	_handle->priority = priority;
 
 	return IMAGE_UTIL_ERROR_NONE;
 }
@@ -435,7 +433,15 @@ int image_util_decode_run_async(image_util_decode_h handle, image_util_decode_co
 	image_util_retvm_if((_handle->path == NULL && _handle->src_buffer == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid input");
 	image_util_retvm_if(_handle->dst_buffer == NULL, IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid output");
 	image_util_retvm_if((completed_cb == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid callback");
-	image_util_retvm_if((_handle->thread != NULL), IMAGE_UTIL_ERROR_INVALID_OPERATION, "A thread is alread running");
+
+	g_mutex_lock(&_handle->async_mutex);
+	if (_handle->running) {
+		g_mutex_unlock(&_handle->async_mutex);
+		image_util_error("The decoding is already running");
+		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
+	}
+	_handle->running = true;
+	g_mutex_unlock(&_handle->async_mutex);
 
 	if (_handle->_decode_cb != NULL) {
 		IMAGE_UTIL_SAFE_FREE(_handle->_decode_cb);
@@ -443,19 +449,34 @@ int image_util_decode_run_async(image_util_decode_h handle, image_util_decode_co
 	}
 
 	_handle->_decode_cb = (decode_cb_s *) calloc(1, sizeof(decode_cb_s));
-	image_util_retvm_if((_handle->_decode_cb == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Out of memory");
+	if (_handle->_decode_cb == NULL) {
+		image_util_error("Out of memory");
+		err = IMAGE_UTIL_ERROR_OUT_OF_MEMORY;
+		goto ERROR;
+	}
 
 	_handle->_decode_cb->user_data = user_data;
 	_handle->_decode_cb->image_decode_completed_cb = completed_cb;
 
-	err = _image_util_decode_create_thread(_handle);
+	err = _image_util_scheduler_push(_handle->priority, _image_util_decode_work, _handle);
 	if (err != IMAGE_UTIL_ERROR_NONE) {
+		image_util_error("_image_util_scheduler_push failed (%d)", err);
 		IMAGE_UTIL_SAFE_FREE(_handle->_decode_cb);
 		_handle->_decode_cb = NULL;
+		goto ERROR;
 	}
 
 	image_util_fleave();
 
+	return err;
+
+ERROR:
+	g_mutex_lock(&_handle->async_mutex);
+	_handle->running = false;
+	g_mutex_unlock(&_handle->async_mutex);
+
+	image_util_fleave();
+
 	return err;
 }
 
@@ -467,11 +488,16 @@ int image_util_decode_destroy(image_util_decode_h handle)
 
 	IMAGE_UTIL_DECODE_HANDLE_CHECK(handle);
 
-	/* g_thread_exit(handle->thread); */
-	if (_handle->thread) {
-		g_thread_join(_handle->thread);
-		IMAGE_UTIL_SAFE_FREE(_handle->_decode_cb);
-	}
+	/* wait for the decoding on the scheduler */
+	g_mutex_lock(&_handle->async_mutex);
+	while (_handle->running)
+		g_cond_wait(&_handle->async_cond, &_handle->async_mutex);
+	g_mutex_unlock(&_handle->async_mutex);
+
+	g_cond_clear(&_handle->async_cond);
+	g_mutex_clear(&_handle->async_mutex);
+
+	IMAGE_UTIL_SAFE_FREE(_handle->_decode_cb);
 	IMAGE_UTIL_SAFE_FREE(_handle->path);
 	IMAGE_UTIL_SAFE_FREE(_handle->src_buffer);
 	IMAGE_UTIL_SAFE_FREE(_handle);
@@ -156,6 +156,10 @@ int image_util_encode_create(image_util_type_e image_type, image_util_encode_h *
 		return err;
 	}
 
+	_handle->priority = IMAGE_UTIL_PRIORITY_NORMAL;
+	g_mutex_init(&_handle->async_mutex);
+	g_cond_init(&_handle->async_cond);
+
 	*handle = (image_util_encode_h) _handle;
 
 	return err;
@@ -478,16 +482,11 @@ int image_util_encode_run(image_util_encode_h handle, unsigned long long *size)
 	return err;
 }
 
-gpointer _image_util_encode_thread(gpointer data)
+static void _image_util_encode_work(void *data)
 {
 	decode_encode_s *_handle = (decode_encode_s *) data;
 	int err = IMAGE_UTIL_ERROR_NONE;
 
-	if (!_handle) {
-		image_util_error("[ERROR] - handle");
-		return NULL;
-	}
-
 	err = _image_util_encode_internal(_handle);
 	if (err == IMAGE_UTIL_ERROR_NONE)
 		image_util_debug("Success - encode_internal");
@@ -500,24 +499,22 @@ gpointer _image_util_encode_thread(gpointer data)
 	}
 
 	IMAGE_UTIL_SAFE_FREE(_handle->_encode_cb);
-	_handle->thread = NULL;
-	image_util_debug("exit thread");
 
-	return NULL;
+	g_mutex_lock(&_handle->async_mutex);
+	_handle->running = false;
+	g_cond_broadcast(&_handle->async_cond);
+	g_mutex_unlock(&_handle->async_mutex);
+	image_util_debug("exit work");
 }
 
-static int _image_util_encode_create_thread(decode_encode_s * handle)
+int image_util_encode_set_priority(image_util_encode_h handle, image_util_priority_e priority)
 {
-	image_util_retvm_if((handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
-	image_util_retvm_if((handle->thread != NULL), IMAGE_UTIL_ERROR_INVALID_OPERATION, "The thread is alread running");
+	decode_encode_s *_handle = (decode_encode_s *) handle;
 
-	/*create threads */
-	handle->thread = g_thread_new("encode_thread", (GThreadFunc) _image_util_encode_thread, (gpointer) handle);
-	if (!handle->thread) {
-		image_util_error("ERROR - create thread");
+	IMAGE_UTIL_ENCODE_HANDLE_CHECK(_handle);
+	image_util_retvm_if((priority < IMAGE_UTIL_PRIORITY_LOW || priority > IMAGE_UTIL_PRIORITY_HIGH), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid priority");
 
-		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
-	}
+	_handle->priority = priority;
 
 	return IMAGE_UTIL_ERROR_NONE;
 }
@@ -532,24 +529,45 @@ int image_util_encode_run_async(image_util_encode_h handle, image_util_encode_co
 	image_util_retvm_if(_handle->image_type != IMAGE_UTIL_GIF && _handle->src_buffer == NULL, IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid input");
 	image_util_retvm_if((_image_util_check_resolution(_handle->width, _handle->height) == false), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid resolution");
 	image_util_retvm_if((completed_cb == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid callback");
-	image_util_retvm_if((_handle->thread != NULL), IMAGE_UTIL_ERROR_INVALID_OPERATION, "The thread is alread running");
+
+	g_mutex_lock(&_handle->async_mutex);
+	if (_handle->running) {
+		g_mutex_unlock(&_handle->async_mutex);
+		image_util_error("The encoding is already running");
+		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
+	}
+	_handle->running = true;
+	g_mutex_unlock(&_handle->async_mutex);
 
 	if (_handle->_encode_cb != NULL) {
 		IMAGE_UTIL_SAFE_FREE(_handle->_encode_cb);
 		_handle->_encode_cb = NULL;
 	}
 	_handle->_encode_cb = (encode_cb_s *) calloc(1, sizeof(encode_cb_s));
-	image_util_retvm_if((_handle->_encode_cb == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Out of memory");
+	if (_handle->_encode_cb == NULL) {
+		image_util_error("Out of memory");
+		err = IMAGE_UTIL_ERROR_OUT_OF_MEMORY;
+		goto ERROR;
+	}
 
 	_handle->_encode_cb->user_data = user_data;
 	_handle->_encode_cb->image_encode_completed_cb = completed_cb;
 
-	err = _image_util_encode_create_thread(_handle);
+	err = _image_util_scheduler_push(_handle->priority, _image_util_encode_work, _handle);
 	if (err != IMAGE_UTIL_ERROR_NONE) {
+		image_util_error("_image_util_scheduler_push failed (%d)", err);
 		IMAGE_UTIL_SAFE_FREE(_handle->_encode_cb);
 		_handle->_encode_cb = NULL;
+		goto ERROR;
 	}
 
+	return err;
+
+ERROR:
+	g_mutex_lock(&_handle->async_mutex);
+	_handle->running = false;
+	g_mutex_unlock(&_handle->async_mutex);
+
 	return err;
 }
 
@@ -562,13 +580,18 @@ int image_util_encode_destroy(image_util_encode_h handle)
 
 	IMAGE_UTIL_ENCODE_HANDLE_CHECK(_handle);
 
+	/* wait for the encoding on the scheduler */
+	g_mutex_lock(&_handle->async_mutex);
+	while (_handle->running)
+		g_cond_wait(&_handle->async_cond, &_handle->async_mutex);
+	g_mutex_unlock(&_handle->async_mutex);
+
+	g_cond_clear(&_handle->async_cond);
+	g_mutex_clear(&_handle->async_mutex);
+
 	_image_util_encode_destroy_image_handle(_handle);
 
-	/* g_thread_exit(handle->thread); */
-	if (_handle->thread) {
-		g_thread_join(_handle->thread);
-		IMAGE_UTIL_SAFE_FREE(_handle->_encode_cb);
-	}
+	IMAGE_UTIL_SAFE_FREE(_handle->_encode_cb);
 
 	IMAGE_UTIL_SAFE_FREE(_handle->path);
 	IMAGE_UTIL_SAFE_FREE(_handle->src_buffer);
@@ -21,6 +21,33 @@
 #include <mm_util_imgp.h>
 #include <mm_util_gif.h>
 
+/* runs the one pass transform, which has the SIMD kernels, if it supports both formats in the same layout as mm_util */
+static int __transform_in_one_pass(unsigned char *dest, image_util_colorspace_e dest_colorspace, unsigned int dest_width, unsigned int dest_height,
+	const unsigned char *src, unsigned int src_width, unsigned int src_height, image_util_colorspace_e src_colorspace, image_util_rotation_e rotation, const transform_options_s *options)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transform_image_s src_image, dst_image;
+	size_t src_size = _transform_get_buffer_size(src_colorspace, src_width, src_height);
+	size_t dst_size = _transform_get_buffer_size(dest_colorspace, dest_width, dest_height);
+	size_t size = 0;
+
+	if (src_size == 0 || dst_size == 0)
+		return IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT;
+
+	if (mm_util_get_image_size(TYPECAST_COLOR(src_colorspace), src_width, src_height, &size) != MM_UTIL_ERROR_NONE || size != src_size)
+		return IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT;
+	if (mm_util_get_image_size(TYPECAST_COLOR(dest_colorspace), dest_width, dest_height, &size) != MM_UTIL_ERROR_NONE || size != dst_size)
+		return IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT;
+
+	err = _transform_set_image(&src_image, src_colorspace, src_width, src_height, (void *)src, src_size);
+	if (err == IMAGE_UTIL_ERROR_NONE)
+		err = _transform_set_image(&dst_image, dest_colorspace, dest_width, dest_height, dest, dst_size);
+	if (err == IMAGE_UTIL_ERROR_NONE)
+		err = _transform_run(&src_image, NULL, rotation, options, &dst_image, NULL, NULL);
+
+	return err;
+}
+
 int image_util_convert_colorspace(unsigned char *dest, image_util_colorspace_e dest_colorspace, const unsigned char *src, int width, int height, image_util_colorspace_e src_colorspace)
 {
 	int err = MM_UTIL_ERROR_NONE;
@@ -33,6 +60,11 @@ int image_util_convert_colorspace(unsigned char *dest, image_util_colorspace_e d
 	image_util_retvm_if((src == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "src is null");
 	image_util_retvm_if((is_valid_colorspace(dest_colorspace) == FALSE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid dst_colorspace");
 	image_util_retvm_if((is_valid_colorspace(src_colorspace) == FALSE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid src_colorspace");
+	image_util_retvm_if((width <= 0 || height <= 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid width or Invalid height");
+
+	err = __transform_in_one_pass(dest, dest_colorspace, (unsigned int)width, (unsigned int)height, src, (unsigned int)width, (unsigned int)height, src_colorspace, IMAGE_UTIL_ROTATION_NONE, NULL);
+	if (err != IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT)
+		return err;
 
 	err = mm_util_convert_colorspace(src, width, height, TYPECAST_COLOR(src_colorspace), TYPECAST_COLOR(dest_colorspace), &res_buffer, &res_w, &res_h, &res_buffer_size);
 	if (err == MM_UTIL_ERROR_NONE)
@@ -44,19 +76,37 @@ int image_util_convert_colorspace(unsigned char *dest, image_util_colorspace_e d
 }
 
 int image_util_resize(unsigned char *dest, int *dest_width, int *dest_height, const unsigned char *src, int src_width, int src_height, image_util_colorspace_e colorspace)
+{
+	return image_util_resize_with_filter(dest, dest_width, dest_height, src, src_width, src_height, colorspace, IMAGE_UTIL_RESIZE_FILTER_BILINEAR);
+}
+
+int image_util_resize_with_filter(unsigned char *dest, int *dest_width, int *dest_height, const unsigned char *src, int src_width, int src_height, image_util_colorspace_e colorspace, image_util_resize_filter_e filter)
 {
 	int err = MM_UTIL_ERROR_NONE;
 	unsigned int res_w = 0;
 	unsigned int res_h = 0;
 	unsigned char *res_buffer = NULL;
 	size_t res_buffer_size = 0;
+	transform_options_s options;
 
 	image_util_retvm_if((dest == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "dest is null");
 	image_util_retvm_if((src == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "src is null");
 	image_util_retvm_if((is_valid_colorspace(colorspace) == FALSE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid colorspace");
 	image_util_retvm_if((dest_width == NULL || dest_height == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "dest_width or dest_height is null");
 	image_util_retvm_if((*dest_width <= 0 || *dest_height <= 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid dest_width or Invalid dest_height");
+	image_util_retvm_if((src_width <= 0 || src_height <= 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid src_width or Invalid src_height");
+	image_util_retvm_if((filter < IMAGE_UTIL_RESIZE_FILTER_NEAREST || filter > IMAGE_UTIL_RESIZE_FILTER_LANCZOS3), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid filter");
+
+	memset(&options, 0, sizeof(transform_options_s));
+	options.filter = filter;
+	options.priority = IMAGE_UTIL_PRIORITY_NORMAL;
 
+	/* the size is kept */
+	err = __transform_in_one_pass(dest, colorspace, (unsigned int)*dest_width, (unsigned int)*dest_height, src, (unsigned int)src_width, (unsigned int)src_height, colorspace, IMAGE_UTIL_ROTATION_NONE, &options);
+	if (err != IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT)
+		return err;
+
+	/* mm_util has only its own filter */
 	err = mm_util_resize_image(src, src_width, src_height, TYPECAST_COLOR(colorspace), *dest_width, *dest_height, &res_buffer, &res_w, &res_h, &res_buffer_size);
 	if (err == MM_UTIL_ERROR_NONE) {
 		memcpy(dest, res_buffer, res_buffer_size);
@@ -64,6 +114,8 @@ int image_util_resize(unsigned char *dest, int *dest_width, int *dest_height, co
 		*dest_height = (int)res_h;
 	}
 
+	IMAGE_UTIL_SAFE_FREE(res_buffer);
+
 	return _image_error_capi(ERR_TYPE_TRANSFORM, err);
 }
 
@@ -80,6 +132,18 @@ int image_util_rotate(unsigned char *dest, int *dest_width, int *dest_height, im
 	image_util_retvm_if((is_valid_colorspace(colorspace) == FALSE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid colorspace");
 	image_util_retvm_if((dest_rotation < 0 || dest_rotation > IMAGE_UTIL_ROTATION_FLIP_VERT), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid rotation");
 	image_util_retvm_if((dest_width == NULL || dest_height == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "dest_width or dest_height is null");
+	image_util_retvm_if((src_width <= 0 || src_height <= 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid src_width or Invalid src_height");
+
+	/* the planes are transposed in the blocks for 90 and 270 degree, and reversed for the flips, also in place if dest is src */
+	_transform_get_output_size((unsigned int)src_width, (unsigned int)src_height, dest_rotation, &res_w, &res_h);
+	err = __transform_in_one_pass(dest, colorspace, res_w, res_h, src, (unsigned int)src_width, (unsigned int)src_height, colorspace, dest_rotation, NULL);
+	if (err != IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT) {
+		if (err == IMAGE_UTIL_ERROR_NONE) {
+			*dest_width = (int)res_w;
+			*dest_height = (int)res_h;
+		}
+		return err;
+	}
 
 	err = mm_util_rotate_image(src, src_width, src_height, TYPECAST_COLOR(colorspace), dest_rotation, &res_buffer, &res_w, &res_h, &res_buffer_size);
 	if (err == MM_UTIL_ERROR_NONE) {
@@ -87,6 +151,9 @@ int image_util_rotate(unsigned char *dest, int *dest_width, int *dest_height, im
 		*dest_width = (int)res_w;
 		*dest_height = (int)res_h;
 	}
+
+	IMAGE_UTIL_SAFE_FREE(res_buffer);
+
 	return _image_error_capi(ERR_TYPE_TRANSFORM, err);
 }
 
@@ -0,0 +1,224 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <image_util_private.h>
+
+/*
+ * The asynchronous works of transform, decode and encode handles run on one thread pool of the process.
+ * The waiting works are sorted by the priority and then by the order of the submission.
+ * The pool has 2 threads at least, and the helping works of a parallel run leave the last free thread to the others,
+ * so a callback which waits for another work doesn't block the pool.
+ */
+
+#define SCHEDULER_MIN_THREADS 2
+
+typedef struct {
+	image_util_priority_e priority;
+	guint64 sequence;
+	scheduler_work_func func;
+	void *data;
+} scheduler_work_s;
+
+static GMutex scheduler_mutex;
+static GThreadPool *scheduler_pool = NULL;
+static guint64 scheduler_sequence = 0;
+static guint scheduler_max_threads = 0;
+static gint scheduler_running = 0;
+
+static gint __compare_work(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+	const scheduler_work_s *work_a = (const scheduler_work_s *) a;
+	const scheduler_work_s *work_b = (const scheduler_work_s *) b;
+
+	if (work_a->priority != work_b->priority)
+		return (work_a->priority > work_b->priority) ? -1 : 1;
+
+	return (work_a->sequence < work_b->sequence) ? -1 : 1;
+}
+
+static void __run_work(gpointer data, gpointer user_data)
+{
+	scheduler_work_s *work = (scheduler_work_s *) data;
+
+	g_atomic_int_inc(&scheduler_running);
+	work->func(work->data);
+	g_atomic_int_add(&scheduler_running, -1);
+
+	IMAGE_UTIL_SAFE_FREE(work);
+}
+
+int _image_util_scheduler_push(image_util_priority_e priority, scheduler_work_func func, void *data)
+{
+	scheduler_work_s *work = NULL;
+
+	image_util_retvm_if((func == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid work");
+
+	work = (scheduler_work_s *) calloc(1, sizeof(scheduler_work_s));
+	image_util_retvm_if((work == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Memory allocation failed");
+
+	work->priority = priority;
+	work->func = func;
+	work->data = data;
+
+	g_mutex_lock(&scheduler_mutex);
+
+	if (scheduler_pool == NULL) {
+		scheduler_max_threads = MAX(SCHEDULER_MIN_THREADS, g_get_num_processors());
+		scheduler_pool = g_thread_pool_new(__run_work, NULL, (gint)scheduler_max_threads, FALSE, NULL);
+		if (scheduler_pool == NULL) {
+			g_mutex_unlock(&scheduler_mutex);
+			image_util_error("g_thread_pool_new failed");
+			IMAGE_UTIL_SAFE_FREE(work);
+			return IMAGE_UTIL_ERROR_INVALID_OPERATION;
+		}
+		g_thread_pool_set_sort_function(scheduler_pool, __compare_work, NULL);
+	}
+
+	work->sequence = scheduler_sequence++;
+
+	if (!g_thread_pool_push(scheduler_pool, work, NULL)) {
+		g_mutex_unlock(&scheduler_mutex);
+		image_util_error("g_thread_pool_push failed");
+		IMAGE_UTIL_SAFE_FREE(work);
+		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
+	}
+
+	g_mutex_unlock(&scheduler_mutex);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* the indexes of a parallel run, which are claimed one by one by the calling thread and the works on the scheduler */
+typedef struct {
+	gint ref_count;
+	unsigned int count;
+	scheduler_parallel_func func;
+	scheduler_local_free_func free_local;
+	void *data;
+	gint next_index;
+	gint error;					/* the first error of the indexes */
+	GMutex mutex;
+	GCond cond;
+	unsigned int done_count;	/* locked by the mutex */
+} scheduler_parallel_s;
+
+static void __parallel_unref(scheduler_parallel_s *parallel)
+{
+	if (!g_atomic_int_dec_and_test(&parallel->ref_count))
+		return;
+
+	g_mutex_clear(&parallel->mutex);
+	g_cond_clear(&parallel->cond);
+	IMAGE_UTIL_SAFE_FREE(parallel);
+}
+
+/* claims and runs the indexes until there's none left, the data is touched only for the claimed ones */
+static void __parallel_claim(scheduler_parallel_s *parallel, void **local)
+{
+	unsigned int index = 0;
+	int err = IMAGE_UTIL_ERROR_NONE;
+
+	while ((index = (unsigned int)g_atomic_int_add(&parallel->next_index, 1)) < parallel->count) {
+		err = parallel->func(parallel->data, index, local);
+		if (err != IMAGE_UTIL_ERROR_NONE)
+			g_atomic_int_compare_and_exchange(&parallel->error, IMAGE_UTIL_ERROR_NONE, err);
+
+		g_mutex_lock(&parallel->mutex);
+		if (++parallel->done_count == parallel->count)
+			g_cond_signal(&parallel->cond);
+		g_mutex_unlock(&parallel->mutex);
+	}
+}
+
+/*
+ * the work on the scheduler, it may start after the run is over and then finds nothing to claim,
+ * it claims nothing either on the last free thread of the pool, the calling thread does the rest
+ */
+static void __parallel_work(void *data)
+{
+	scheduler_parallel_s *parallel = (scheduler_parallel_s *) data;
+	scheduler_local_free_func free_local = parallel->free_local;
+	void *local = NULL;
+
+	if ((guint)g_atomic_int_get(&scheduler_running) < scheduler_max_threads)
+		__parallel_claim(parallel, &local);
+
+	if (local && free_local)
+		free_local(local);
+
+	__parallel_unref(parallel);
+}
+
+int _image_util_scheduler_run_parallel(image_util_priority_e priority, unsigned int count, unsigned int max_threads,
+	scheduler_parallel_func func, scheduler_local_free_func free_local, void *data, void *local)
+{
+	int err = IMAGE_UTIL_ERROR_NONE, ret = IMAGE_UTIL_ERROR_NONE;
+	scheduler_parallel_s *parallel = NULL;
+	unsigned int num_threads = g_get_num_processors(), i = 0;
+	void *caller_local = local;
+
+	image_util_retvm_if((func == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid function");
+
+	if (max_threads > 0 && max_threads < num_threads)
+		num_threads = max_threads;
+	if (count < num_threads)
+		num_threads = count;
+
+	parallel = (scheduler_parallel_s *) calloc(1, sizeof(scheduler_parallel_s));
+	if (parallel == NULL) {
+		image_util_error("Memory allocation failed, the indexes are run in order");
+		for (i = 0; i < count; i++) {
+			ret = func(data, i, &caller_local);
+			if (err == IMAGE_UTIL_ERROR_NONE)
+				err = ret;
+		}
+		if (caller_local != local && free_local)
+			free_local(caller_local);
+		return err;
+	}
+
+	parallel->ref_count = 1;
+	parallel->count = count;
+	parallel->func = func;
+	parallel->free_local = free_local;
+	parallel->data = data;
+	g_mutex_init(&parallel->mutex);
+	g_cond_init(&parallel->cond);
+
+	for (i = 1; i < num_threads; i++) {
+		g_atomic_int_inc(&parallel->ref_count);
+		if (_image_util_scheduler_push(priority, __parallel_work, parallel) != IMAGE_UTIL_ERROR_NONE) {
+			g_atomic_int_add(&parallel->ref_count, -1);
+			break;
+		}
+	}
+
+	/* the calling thread claims the indexes as well, so the run ends even if the works haven't started */
+	__parallel_claim(parallel, &caller_local);
+	if (caller_local != local && free_local)
+		free_local(caller_local);
+
+	g_mutex_lock(&parallel->mutex);
+	while (parallel->done_count < count)
+		g_cond_wait(&parallel->cond, &parallel->mutex);
+	g_mutex_unlock(&parallel->mutex);
+
+	err = g_atomic_int_get(&parallel->error);
+
+	__parallel_unref(parallel);
+
+	return err;
+}
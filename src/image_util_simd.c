@@ -0,0 +1,1872 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+ * The SIMD kernels of the transform, which are selected at runtime by the features of the CPU.
+ * They give the same results as the scalar kernels in image_util_color.c, which convert the rest
+ * of the rows which are shorter than a vector.
+ * The x86 kernels are built with the target attributes, so the library doesn't need the flags for them.
+ */
+
+#include <image_util_private.h>
+#include <image_util_transform_private.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/* the pixels of a vector step */
+#define SIMD_STEP	16
+
+#if defined(SIMD_X86) || defined(SIMD_NEON)
+/* transposes the right and the bottom of the @width x @height samples which are out of the @n x @n blocks by the reference */
+static void __transpose_rest(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride,
+	unsigned int width, unsigned int height, unsigned int size, unsigned int n)
+{
+	unsigned int bw = width - width % n, bh = height - height % n;
+
+	if (bw < width)
+		_transform_transpose(in + (size_t)bw * size, in_stride, out + (ptrdiff_t)bw * out_stride, out_stride, width - bw, height, size);
+	if (bh < height)
+		_transform_transpose(in + (ptrdiff_t)bh * in_stride, in_stride, out + (size_t)bh * size, out_stride, bw, height - bh, size);
+}
+#endif
+
+#ifdef SIMD_X86
+
+/* the pair of the int16 coefficients for _mm_madd_epi16() */
+#define SIMD_PAIR(a, b)	((int)(((unsigned int)(unsigned short)(b) << 16) | (unsigned short)(a)))
+
+/* loads the 8 chroma of the 16 pixels from @i as int16 - 128 */
+__attribute__((target("sse2")))
+static inline void __sse2_load_uv(const unsigned char *pu, const unsigned char *pv, unsigned int uv_step, unsigned int i, __m128i *d, __m128i *e)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i bias = _mm_set1_epi16(128);
+	const unsigned char *base = NULL;
+	__m128i uv, even, odd;
+
+	if (uv_step == 1) {
+		*d = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(pu + i / 2)), zero), bias);
+		*e = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(pv + i / 2)), zero), bias);
+		return;
+	}
+
+	base = (pu < pv) ? pu : pv;
+	uv = _mm_loadu_si128((const __m128i *)(base + i));
+	even = _mm_sub_epi16(_mm_and_si128(uv, _mm_set1_epi16(0xff)), bias);
+	odd = _mm_sub_epi16(_mm_srli_epi16(uv, 8), bias);
+
+	*d = (pu < pv) ? even : odd;
+	*e = (pu < pv) ? odd : even;
+}
+
+/* 8 pixels of the int16 y - 16, u - 128 and v - 128 into the int16 R, G and B, see __yuv_to_rgb() */
+__attribute__((target("sse2")))
+static inline void __sse2_yuv_to_rgb(__m128i y, __m128i d, __m128i e, __m128i *r, __m128i *g, __m128i *b)
+{
+	const __m128i one = _mm_set1_epi16(1);
+	__m128i c_lo = _mm_madd_epi16(_mm_unpacklo_epi16(y, one), _mm_set1_epi32(SIMD_PAIR(298, 128)));
+	__m128i c_hi = _mm_madd_epi16(_mm_unpackhi_epi16(y, one), _mm_set1_epi32(SIMD_PAIR(298, 128)));
+	__m128i de_lo = _mm_unpacklo_epi16(d, e);
+	__m128i de_hi = _mm_unpackhi_epi16(d, e);
+
+#define SSE2_CHANNEL(k0, k1) \
+	_mm_packs_epi32( \
+		_mm_srai_epi32(_mm_add_epi32(c_lo, _mm_madd_epi16(de_lo, _mm_set1_epi32(SIMD_PAIR(k0, k1)))), 8), \
+		_mm_srai_epi32(_mm_add_epi32(c_hi, _mm_madd_epi16(de_hi, _mm_set1_epi32(SIMD_PAIR(k0, k1)))), 8))
+
+	*r = SSE2_CHANNEL(0, 409);
+	*g = SSE2_CHANNEL(-100, -208);
+	*b = SSE2_CHANNEL(516, 0);
+
+#undef SSE2_CHANNEL
+}
+
+/* interleaves the 16 pixels of R, G and B into @out in @order */
+__attribute__((target("sse2")))
+static inline void __sse2_store(unsigned char *out, __m128i r, __m128i g, __m128i b, transform_order_e order)
+{
+	const __m128i a = _mm_set1_epi8((char)0xff);
+	__m128i c0 = r, c1 = g, c2 = b, c3 = a;
+	__m128i t0, t1, t2, t3;
+
+	if (order == TRANSFORM_ORDER_BGRA) {
+		c0 = b;
+		c2 = r;
+	} else if (order == TRANSFORM_ORDER_ARGB) {
+		c0 = a;
+		c1 = r;
+		c2 = g;
+		c3 = b;
+	}
+
+	t0 = _mm_unpacklo_epi8(c0, c1);
+	t1 = _mm_unpackhi_epi8(c0, c1);
+	t2 = _mm_unpacklo_epi8(c2, c3);
+	t3 = _mm_unpackhi_epi8(c2, c3);
+
+	_mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi16(t0, t2));
+	_mm_storeu_si128((__m128i *)(out + 16), _mm_unpackhi_epi16(t0, t2));
+	_mm_storeu_si128((__m128i *)(out + 32), _mm_unpacklo_epi16(t1, t3));
+	_mm_storeu_si128((__m128i *)(out + 48), _mm_unpackhi_epi16(t1, t3));
+}
+
+__attribute__((target("sse2")))
+static void __sse2_yuv_to_rgb_row(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int uv_step, unsigned char *out, unsigned int width, transform_order_e order)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i bias = _mm_set1_epi16(16);
+	unsigned int i = 0;
+	__m128i y, d, e, r0, g0, b0, r1, g1, b1;
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		y = _mm_loadu_si128((const __m128i *)(py + i));
+		__sse2_load_uv(pu, pv, uv_step, i, &d, &e);
+
+		__sse2_yuv_to_rgb(_mm_sub_epi16(_mm_unpacklo_epi8(y, zero), bias), _mm_unpacklo_epi16(d, d), _mm_unpacklo_epi16(e, e), &r0, &g0, &b0);
+		__sse2_yuv_to_rgb(_mm_sub_epi16(_mm_unpackhi_epi8(y, zero), bias), _mm_unpackhi_epi16(d, d), _mm_unpackhi_epi16(e, e), &r1, &g1, &b1);
+
+		__sse2_store(out + (size_t)i * TRANSFORM_PIXEL_SIZE, _mm_packus_epi16(r0, r1), _mm_packus_epi16(g0, g1), _mm_packus_epi16(b0, b1), order);
+	}
+
+	if (i < width)
+		_transform_yuv_to_rgb_row(py + i, pu + i / 2 * uv_step, pv + i / 2 * uv_step, uv_step, out + (size_t)i * TRANSFORM_PIXEL_SIZE, width - i, order);
+}
+
+/* the bit offsets of R, G and B in the 32 bits pixel of each transform_order_e */
+static const int _simd_shift_tbl[][3] = {
+	{ 0, 8, 16 },		/* TRANSFORM_ORDER_RGBA */
+	{ 16, 8, 0 },		/* TRANSFORM_ORDER_BGRA */
+	{ 8, 16, 24 },		/* TRANSFORM_ORDER_ARGB */
+};
+
+/* the channel at the bit @shift of the 8 pixels of @p0 and @p1 as int16 */
+__attribute__((target("sse2")))
+static inline __m128i __sse2_channel(__m128i p0, __m128i p1, int shift)
+{
+	const __m128i mask = _mm_set1_epi32(0xff);
+
+	return _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, shift), mask), _mm_and_si128(_mm_srli_epi32(p1, shift), mask));
+}
+
+/*
+ * 8 pixels of the int16 R, G and B into the int16 Y, U and V, see __rgb_to_yuv().
+ * The sums of Y don't fit in int16 but in uint16 and the sums of U and V fit in int16,
+ * so they are made by the wrapping 16 bits multiplies.
+ */
+__attribute__((target("sse2")))
+static inline void __sse2_rgb_to_yuv(__m128i r, __m128i g, __m128i b, __m128i *y, __m128i *u, __m128i *v)
+{
+	const __m128i round = _mm_set1_epi16(128);
+
+#define SSE2_SUM(kr, kg, kb) \
+	_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(kr)), _mm_mullo_epi16(g, _mm_set1_epi16(kg))), \
+		_mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(kb)), round))
+
+	*y = _mm_add_epi16(_mm_srli_epi16(SSE2_SUM(66, 129, 25), 8), _mm_set1_epi16(16));
+	*u = _mm_add_epi16(_mm_srai_epi16(SSE2_SUM(-38, -74, 112), 8), round);
+	*v = _mm_add_epi16(_mm_srai_epi16(SSE2_SUM(112, -94, -18), 8), round);
+
+#undef SSE2_SUM
+}
+
+/* converts the 16 pixels of @in into @py and the int32 sums of the chroma of each 2 pixels */
+__attribute__((target("sse2")))
+static inline void __sse2_convert(const unsigned char *in, const int *shift, unsigned char *py, __m128i *su_lo, __m128i *su_hi, __m128i *sv_lo, __m128i *sv_hi)
+{
+	const __m128i one = _mm_set1_epi16(1);
+	__m128i p0 = _mm_loadu_si128((const __m128i *)in);
+	__m128i p1 = _mm_loadu_si128((const __m128i *)(in + 16));
+	__m128i p2 = _mm_loadu_si128((const __m128i *)(in + 32));
+	__m128i p3 = _mm_loadu_si128((const __m128i *)(in + 48));
+	__m128i y0, u0, v0, y1, u1, v1;
+
+	__sse2_rgb_to_yuv(__sse2_channel(p0, p1, shift[0]), __sse2_channel(p0, p1, shift[1]), __sse2_channel(p0, p1, shift[2]), &y0, &u0, &v0);
+	__sse2_rgb_to_yuv(__sse2_channel(p2, p3, shift[0]), __sse2_channel(p2, p3, shift[1]), __sse2_channel(p2, p3, shift[2]), &y1, &u1, &v1);
+
+	_mm_storeu_si128((__m128i *)py, _mm_packus_epi16(y0, y1));
+
+	*su_lo = _mm_add_epi32(*su_lo, _mm_madd_epi16(u0, one));
+	*su_hi = _mm_add_epi32(*su_hi, _mm_madd_epi16(u1, one));
+	*sv_lo = _mm_add_epi32(*sv_lo, _mm_madd_epi16(v0, one));
+	*sv_hi = _mm_add_epi32(*sv_hi, _mm_madd_epi16(v1, one));
+}
+
+/* stores the 8 chroma in the low bytes of @u and @v at the chroma of the pixel @i */
+__attribute__((target("sse2")))
+static inline void __sse2_store_uv(unsigned char *pu, unsigned char *pv, unsigned int uv_step, unsigned int i, __m128i u, __m128i v)
+{
+	if (uv_step == 1) {
+		_mm_storel_epi64((__m128i *)(pu + i / 2), u);
+		_mm_storel_epi64((__m128i *)(pv + i / 2), v);
+		return;
+	}
+
+	if (pu < pv)
+		_mm_storeu_si128((__m128i *)(pu + i), _mm_unpacklo_epi8(u, v));
+	else
+		_mm_storeu_si128((__m128i *)(pv + i), _mm_unpacklo_epi8(v, u));
+}
+
+/* the rounded averages of the 8 sums of @n chroma, n is 2 or 4 */
+__attribute__((target("sse2")))
+static inline __m128i __sse2_average(__m128i lo, __m128i hi, int n)
+{
+	int shift = n >> 1;
+	__m128i round = _mm_set1_epi32(1 << (shift - 1));
+
+	lo = _mm_srai_epi32(_mm_add_epi32(lo, round), shift);
+	hi = _mm_srai_epi32(_mm_add_epi32(hi, round), shift);
+
+	return _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+}
+
+__attribute__((target("sse2")))
+static void __sse2_rgb_to_yuv_row(const unsigned char *row0, const unsigned char *row1, unsigned char *py0, unsigned char *py1, unsigned char *pu, unsigned char *pv, unsigned int uv_step, unsigned int width, transform_order_e order)
+{
+	const int *shift = _simd_shift_tbl[order];
+	int n = row1 ? 4 : 2;
+	unsigned int i = 0;
+	__m128i su_lo, su_hi, sv_lo, sv_hi;
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		su_lo = su_hi = sv_lo = sv_hi = _mm_setzero_si128();
+
+		__sse2_convert(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE, shift, py0 + i, &su_lo, &su_hi, &sv_lo, &sv_hi);
+		if (row1)
+			__sse2_convert(row1 + (size_t)i * TRANSFORM_PIXEL_SIZE, shift, py1 + i, &su_lo, &su_hi, &sv_lo, &sv_hi);
+
+		__sse2_store_uv(pu, pv, uv_step, i, __sse2_average(su_lo, su_hi, n), __sse2_average(sv_lo, sv_hi, n));
+	}
+
+	if (i < width)
+		_transform_rgb_to_yuv_row(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE, row1 ? row1 + (size_t)i * TRANSFORM_PIXEL_SIZE : NULL,
+			py0 + i, py1 ? py1 + i : NULL, pu + i / 2 * uv_step, pv + i / 2 * uv_step, uv_step, width - i, order);
+}
+
+/* the chroma kernels step by 16 chroma or 16 pixels */
+__attribute__((target("sse2")))
+static void __sse2_split_uv(const unsigned char *uv, unsigned char *u, unsigned char *v, unsigned int count)
+{
+	const __m128i mask = _mm_set1_epi16(0xff);
+	unsigned int i = 0;
+	__m128i a, b;
+
+	for (i = 0; i + SIMD_STEP <= count; i += SIMD_STEP) {
+		a = _mm_loadu_si128((const __m128i *)(uv + i * 2));
+		b = _mm_loadu_si128((const __m128i *)(uv + i * 2 + 16));
+		_mm_storeu_si128((__m128i *)(u + i), _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+		_mm_storeu_si128((__m128i *)(v + i), _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+	}
+
+	if (i < count)
+		_transform_split_uv(uv + i * 2, u + i, v + i, count - i);
+}
+
+__attribute__((target("sse2")))
+static void __sse2_merge_uv(const unsigned char *u, const unsigned char *v, unsigned char *uv, unsigned int count)
+{
+	unsigned int i = 0;
+	__m128i a, b;
+
+	for (i = 0; i + SIMD_STEP <= count; i += SIMD_STEP) {
+		a = _mm_loadu_si128((const __m128i *)(u + i));
+		b = _mm_loadu_si128((const __m128i *)(v + i));
+		_mm_storeu_si128((__m128i *)(uv + i * 2), _mm_unpacklo_epi8(a, b));
+		_mm_storeu_si128((__m128i *)(uv + i * 2 + 16), _mm_unpackhi_epi8(a, b));
+	}
+
+	if (i < count)
+		_transform_merge_uv(u + i, v + i, uv + i * 2, count - i);
+}
+
+__attribute__((target("sse2")))
+static void __sse2_split_packed(const unsigned char *in, unsigned int y_idx, unsigned char *py, unsigned char *pu, unsigned char *pv, unsigned int width)
+{
+	const __m128i mask = _mm_set1_epi16(0xff);
+	unsigned int i = 0;
+	__m128i a, b, uv;
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		a = _mm_loadu_si128((const __m128i *)(in + i * 2));
+		b = _mm_loadu_si128((const __m128i *)(in + i * 2 + 16));
+
+		if (y_idx == 0) {
+			_mm_storeu_si128((__m128i *)(py + i), _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+			uv = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+		} else {
+			_mm_storeu_si128((__m128i *)(py + i), _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+			uv = _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+		}
+
+		_mm_storel_epi64((__m128i *)(pu + i / 2), _mm_packus_epi16(_mm_and_si128(uv, mask), _mm_setzero_si128()));
+		_mm_storel_epi64((__m128i *)(pv + i / 2), _mm_packus_epi16(_mm_srli_epi16(uv, 8), _mm_setzero_si128()));
+	}
+
+	if (i < width)
+		_transform_split_packed(in + i * 2, y_idx, py + i, pu + i / 2, pv + i / 2, width - i);
+}
+
+__attribute__((target("sse2")))
+static void __sse2_merge_packed(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int y_idx, unsigned char *out, unsigned int width)
+{
+	unsigned int i = 0;
+	__m128i y, uv;
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		y = _mm_loadu_si128((const __m128i *)(py + i));
+		uv = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(pu + i / 2)), _mm_loadl_epi64((const __m128i *)(pv + i / 2)));
+
+		if (y_idx == 0) {
+			_mm_storeu_si128((__m128i *)(out + i * 2), _mm_unpacklo_epi8(y, uv));
+			_mm_storeu_si128((__m128i *)(out + i * 2 + 16), _mm_unpackhi_epi8(y, uv));
+		} else {
+			_mm_storeu_si128((__m128i *)(out + i * 2), _mm_unpacklo_epi8(uv, y));
+			_mm_storeu_si128((__m128i *)(out + i * 2 + 16), _mm_unpackhi_epi8(uv, y));
+		}
+	}
+
+	if (i < width)
+		_transform_merge_packed(py + i, pu + i / 2, pv + i / 2, y_idx, out + i * 2, width - i);
+}
+
+/* _mm_avg_epu8() is (a + b + 1) >> 1 */
+__attribute__((target("sse2")))
+static void __sse2_average_rows(const unsigned char *a, const unsigned char *b, unsigned char *out, unsigned int count)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i + SIMD_STEP <= count; i += SIMD_STEP)
+		_mm_storeu_si128((__m128i *)(out + i), _mm_avg_epu8(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i))));
+
+	if (i < count)
+		_transform_average(a + i, b + i, out + i, count - i);
+}
+
+/* expands the 8 RGB565 pixels of @c into the int16 R, G and B, see _transform_unpack_rgb565_row() */
+__attribute__((target("sse2")))
+static inline void __sse2_unpack_rgb565(__m128i c, __m128i *r, __m128i *g, __m128i *b)
+{
+	__m128i t = _mm_srli_epi16(c, 11);
+
+	*r = _mm_or_si128(_mm_slli_epi16(t, 3), _mm_srli_epi16(t, 2));
+	t = _mm_and_si128(_mm_srli_epi16(c, 5), _mm_set1_epi16(0x3f));
+	*g = _mm_or_si128(_mm_slli_epi16(t, 2), _mm_srli_epi16(t, 4));
+	t = _mm_and_si128(c, _mm_set1_epi16(0x1f));
+	*b = _mm_or_si128(_mm_slli_epi16(t, 3), _mm_srli_epi16(t, 2));
+}
+
+__attribute__((target("sse2")))
+static void __sse2_unpack_rgb565_row(const unsigned char *in, unsigned char *out, unsigned int width, transform_order_e order)
+{
+	unsigned int i = 0;
+	__m128i r0, g0, b0, r1, g1, b1;
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		__sse2_unpack_rgb565(_mm_loadu_si128((const __m128i *)(in + i * 2)), &r0, &g0, &b0);
+		__sse2_unpack_rgb565(_mm_loadu_si128((const __m128i *)(in + i * 2 + 16)), &r1, &g1, &b1);
+		__sse2_store(out + (size_t)i * TRANSFORM_PIXEL_SIZE, _mm_packus_epi16(r0, r1), _mm_packus_epi16(g0, g1), _mm_packus_epi16(b0, b1), order);
+	}
+
+	if (i < width)
+		_transform_unpack_rgb565_row(in + i * 2, out + (size_t)i * TRANSFORM_PIXEL_SIZE, width - i, order);
+}
+
+/* packs the 8 pixels of the int16 R, G and B, @dr and @dg are the thresholds of the dither or NULL */
+__attribute__((target("sse2")))
+static inline __m128i __sse2_pack_rgb565(__m128i r, __m128i g, __m128i b, const __m128i *dr, const __m128i *dg)
+{
+	if (dr) {
+		r = _mm_sub_epi16(_mm_add_epi16(r, *dr), _mm_srli_epi16(r, 5));
+		g = _mm_sub_epi16(_mm_add_epi16(g, *dg), _mm_srli_epi16(g, 6));
+		b = _mm_sub_epi16(_mm_add_epi16(b, *dr), _mm_srli_epi16(b, 5));
+	}
+
+	return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(r, 3), 11), _mm_slli_epi16(_mm_srli_epi16(g, 2), 5)), _mm_srli_epi16(b, 3));
+}
+
+/* 16 pixels per step, the channels are gathered as for __sse2_rgb_to_yuv_row() */
+__attribute__((target("sse2")))
+static void __sse2_pack_rgb565_row(const unsigned char *in, unsigned char *out, unsigned int width, transform_order_e order, const unsigned char *dither)
+{
+	const int *shift = _simd_shift_tbl[order];
+	__m128i p0, p1, p2, p3;
+	__m128i dr = _mm_setzero_si128(), dg = _mm_setzero_si128();
+	unsigned int i = 0;
+
+	/* the matrix repeats every 4 pixels, so the 8 lanes start at the same column in every step */
+	if (dither) {
+		dr = _mm_setr_epi16(dither[0] >> 1, dither[1] >> 1, dither[2] >> 1, dither[3] >> 1, dither[0] >> 1, dither[1] >> 1, dither[2] >> 1, dither[3] >> 1);
+		dg = _mm_setr_epi16(dither[0] >> 2, dither[1] >> 2, dither[2] >> 2, dither[3] >> 2, dither[0] >> 2, dither[1] >> 2, dither[2] >> 2, dither[3] >> 2);
+	}
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		p0 = _mm_loadu_si128((const __m128i *)(in + i * 4));
+		p1 = _mm_loadu_si128((const __m128i *)(in + i * 4 + 16));
+		p2 = _mm_loadu_si128((const __m128i *)(in + i * 4 + 32));
+		p3 = _mm_loadu_si128((const __m128i *)(in + i * 4 + 48));
+
+		_mm_storeu_si128((__m128i *)(out + i * 2), __sse2_pack_rgb565(__sse2_channel(p0, p1, shift[0]), __sse2_channel(p0, p1, shift[1]), __sse2_channel(p0, p1, shift[2]),
+			dither ? &dr : NULL, dither ? &dg : NULL));
+		_mm_storeu_si128((__m128i *)(out + i * 2 + 16), __sse2_pack_rgb565(__sse2_channel(p2, p3, shift[0]), __sse2_channel(p2, p3, shift[1]), __sse2_channel(p2, p3, shift[2]),
+			dither ? &dr : NULL, dither ? &dg : NULL));
+	}
+
+	if (i < width)
+		_transform_pack_rgb565_row(in + (size_t)i * TRANSFORM_PIXEL_SIZE, out + i * 2, width - i, order, dither);
+}
+
+/*
+ * the 2 taps of each _mm_madd_epi16() are the 2 pixels which are interleaved by the channels,
+ * the sums fit in int32 and they are the same as the sums of _transform_resample_h_row()
+ */
+__attribute__((target("sse2")))
+static void __sse2_resample_h_row(const unsigned char *in, unsigned char *out, unsigned int width, const unsigned int *first, const unsigned int *count, const short *weights, unsigned int taps)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i half = _mm_set1_epi32(1 << (TRANSFORM_FILTER_BITS - 1));
+	const unsigned char *p = NULL;
+	const short *w = NULL;
+	unsigned int i = 0, k = 0;
+	__m128i acc, px;
+	int pixel = 0;
+
+	for (i = 0; i < width; i++) {
+		p = in + (size_t)first[i] * TRANSFORM_PIXEL_SIZE;
+		w = weights + (size_t)i * taps;
+		acc = half;
+
+		for (k = 0; k + 2 <= count[i]; k += 2) {
+			px = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p + k * TRANSFORM_PIXEL_SIZE)), zero);
+			px = _mm_unpacklo_epi16(px, _mm_srli_si128(px, 8));
+			acc = _mm_add_epi32(acc, _mm_madd_epi16(px, _mm_set1_epi32(SIMD_PAIR(w[k], w[k + 1]))));
+		}
+
+		if (k < count[i]) {
+			memcpy(&pixel, p + k * TRANSFORM_PIXEL_SIZE, TRANSFORM_PIXEL_SIZE);
+			px = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero);
+			acc = _mm_add_epi32(acc, _mm_madd_epi16(px, _mm_set1_epi32(SIMD_PAIR(w[k], 0))));
+		}
+
+		acc = _mm_packs_epi32(_mm_srai_epi32(acc, TRANSFORM_FILTER_BITS), zero);
+		pixel = _mm_cvtsi128_si32(_mm_packus_epi16(acc, zero));
+		memcpy(out + (size_t)i * TRANSFORM_PIXEL_SIZE, &pixel, TRANSFORM_PIXEL_SIZE);
+	}
+}
+
+/* 16 bytes of each 2 rows per _mm_madd_epi16(), the last step overlaps the previous one instead of the scalar tail */
+__attribute__((target("sse2")))
+static void __sse2_resample_v_row(const unsigned char *const *rows, const short *weights, unsigned int count, unsigned char *out, unsigned int size)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i half = _mm_set1_epi32(1 << (TRANSFORM_FILTER_BITS - 1));
+	unsigned int i = 0, k = 0;
+	__m128i a, b, w, lo, hi, acc0, acc1, acc2, acc3;
+
+	if (size < SIMD_STEP) {
+		_transform_resample_v_row(rows, weights, count, out, size);
+		return;
+	}
+
+	for (i = 0; i < size; i += SIMD_STEP) {
+		if (i + SIMD_STEP > size)
+			i = size - SIMD_STEP;
+
+		acc0 = acc1 = acc2 = acc3 = half;
+
+		for (k = 0; k < count; k += 2) {
+			a = _mm_loadu_si128((const __m128i *)(rows[k] + i));
+			b = (k + 1 < count) ? _mm_loadu_si128((const __m128i *)(rows[k + 1] + i)) : zero;
+			w = _mm_set1_epi32(SIMD_PAIR(weights[k], (k + 1 < count) ? weights[k + 1] : 0));
+
+			lo = _mm_unpacklo_epi8(a, b);
+			hi = _mm_unpackhi_epi8(a, b);
+			acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), w));
+			acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), w));
+			acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), w));
+			acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), w));
+		}
+
+		acc0 = _mm_packs_epi32(_mm_srai_epi32(acc0, TRANSFORM_FILTER_BITS), _mm_srai_epi32(acc1, TRANSFORM_FILTER_BITS));
+		acc2 = _mm_packs_epi32(_mm_srai_epi32(acc2, TRANSFORM_FILTER_BITS), _mm_srai_epi32(acc3, TRANSFORM_FILTER_BITS));
+		_mm_storeu_si128((__m128i *)(out + i), _mm_packus_epi16(acc0, acc2));
+	}
+}
+
+/* 8 pixels of each row into 4 pixels per step, the sums of the pixel pairs of both rows are made in 16 bits */
+__attribute__((target("sse2")))
+static void __sse2_halve_row(const unsigned char *row0, const unsigned char *row1, unsigned char *out, unsigned int width)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i two = _mm_set1_epi16(2);
+	unsigned int i = 0;
+	__m128i a0, a1, b0, b1, s0, s1, s2, s3, t0, t1;
+
+	for (i = 0; i + 8 <= width; i += 8) {
+		a0 = _mm_loadu_si128((const __m128i *)(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE));
+		a1 = _mm_loadu_si128((const __m128i *)(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE + 16));
+		b0 = _mm_loadu_si128((const __m128i *)(row1 + (size_t)i * TRANSFORM_PIXEL_SIZE));
+		b1 = _mm_loadu_si128((const __m128i *)(row1 + (size_t)i * TRANSFORM_PIXEL_SIZE + 16));
+
+		/* the pixels 0 and 1, 2 and 3, ... of both rows */
+		s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+		s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+		s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+		s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+		t0 = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+		t1 = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+		t0 = _mm_srli_epi16(_mm_add_epi16(t0, two), 2);
+		t1 = _mm_srli_epi16(_mm_add_epi16(t1, two), 2);
+
+		_mm_storeu_si128((__m128i *)(out + (size_t)(i / 2) * TRANSFORM_PIXEL_SIZE), _mm_packus_epi16(t0, t1));
+	}
+
+	if (i < width)
+		_transform_halve_row(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE, row1 + (size_t)i * TRANSFORM_PIXEL_SIZE, out + (size_t)(i / 2) * TRANSFORM_PIXEL_SIZE, width - i);
+}
+
+/*
+ * 8x8 bytes per block, the 8 bytes rows are interleaved by 8, 16 and 32 bits into the pairs of the output rows.
+ * The blocks go down the columns, so the output rows are written in order and the input lines stay in the cache.
+ */
+__attribute__((target("sse2")))
+static void __sse2_transpose_8(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height)
+{
+	unsigned int x = 0, y = 0, k = 0;
+	const unsigned char *p = NULL;
+	unsigned char *q = NULL;
+	__m128i r[8], a0, a1, a2, a3, b0, b1, b2, b3, c[4];
+
+	for (x = 0; x + 8 <= width; x += 8) {
+		for (y = 0; y + 8 <= height; y += 8) {
+			p = in + (ptrdiff_t)y * in_stride + x;
+			for (k = 0; k < 8; k++)
+				r[k] = _mm_loadl_epi64((const __m128i *)(p + (ptrdiff_t)k * in_stride));
+
+			a0 = _mm_unpacklo_epi8(r[0], r[1]);
+			a1 = _mm_unpacklo_epi8(r[2], r[3]);
+			a2 = _mm_unpacklo_epi8(r[4], r[5]);
+			a3 = _mm_unpacklo_epi8(r[6], r[7]);
+			b0 = _mm_unpacklo_epi16(a0, a1);
+			b1 = _mm_unpackhi_epi16(a0, a1);
+			b2 = _mm_unpacklo_epi16(a2, a3);
+			b3 = _mm_unpackhi_epi16(a2, a3);
+			c[0] = _mm_unpacklo_epi32(b0, b2);
+			c[1] = _mm_unpackhi_epi32(b0, b2);
+			c[2] = _mm_unpacklo_epi32(b1, b3);
+			c[3] = _mm_unpackhi_epi32(b1, b3);
+
+			q = out + (ptrdiff_t)x * out_stride + y;
+			for (k = 0; k < 4; k++) {
+				_mm_storel_epi64((__m128i *)(q + (ptrdiff_t)(k * 2) * out_stride), c[k]);
+				_mm_storel_epi64((__m128i *)(q + (ptrdiff_t)(k * 2 + 1) * out_stride), _mm_srli_si128(c[k], 8));
+			}
+		}
+	}
+
+	__transpose_rest(in, in_stride, out, out_stride, width, height, 1, 8);
+}
+
+/* 8x8 of 2 bytes per block */
+__attribute__((target("sse2")))
+static void __sse2_transpose_16(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height)
+{
+	unsigned int x = 0, y = 0, k = 0;
+	const unsigned char *p = NULL;
+	unsigned char *q = NULL;
+	__m128i r[8], a[8], b[8];
+
+	for (x = 0; x + 8 <= width; x += 8) {
+		for (y = 0; y + 8 <= height; y += 8) {
+			p = in + (ptrdiff_t)y * in_stride + (size_t)x * 2;
+			for (k = 0; k < 8; k++)
+				r[k] = _mm_loadu_si128((const __m128i *)(p + (ptrdiff_t)k * in_stride));
+
+			for (k = 0; k < 8; k += 2) {
+				a[k] = _mm_unpacklo_epi16(r[k], r[k + 1]);
+				a[k + 1] = _mm_unpackhi_epi16(r[k], r[k + 1]);
+			}
+			for (k = 0; k < 8; k += 4) {
+				b[k] = _mm_unpacklo_epi32(a[k], a[k + 2]);
+				b[k + 1] = _mm_unpackhi_epi32(a[k], a[k + 2]);
+				b[k + 2] = _mm_unpacklo_epi32(a[k + 1], a[k + 3]);
+				b[k + 3] = _mm_unpackhi_epi32(a[k + 1], a[k + 3]);
+			}
+
+			q = out + (ptrdiff_t)x * out_stride + (size_t)y * 2;
+			for (k = 0; k < 4; k++) {
+				_mm_storeu_si128((__m128i *)(q + (ptrdiff_t)(k * 2) * out_stride), _mm_unpacklo_epi64(b[k], b[k + 4]));
+				_mm_storeu_si128((__m128i *)(q + (ptrdiff_t)(k * 2 + 1) * out_stride), _mm_unpackhi_epi64(b[k], b[k + 4]));
+			}
+		}
+	}
+
+	__transpose_rest(in, in_stride, out, out_stride, width, height, 2, 8);
+}
+
+/* 4x4 of 4 bytes per block */
+__attribute__((target("sse2")))
+static void __sse2_transpose_32(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height)
+{
+	unsigned int x = 0, y = 0;
+	const unsigned char *p = NULL;
+	unsigned char *q = NULL;
+	__m128i r0, r1, r2, r3, a0, a1, a2, a3;
+
+	for (x = 0; x + 4 <= width; x += 4) {
+		for (y = 0; y + 4 <= height; y += 4) {
+			p = in + (ptrdiff_t)y * in_stride + (size_t)x * 4;
+			r0 = _mm_loadu_si128((const __m128i *)p);
+			r1 = _mm_loadu_si128((const __m128i *)(p + in_stride));
+			r2 = _mm_loadu_si128((const __m128i *)(p + in_stride * 2));
+			r3 = _mm_loadu_si128((const __m128i *)(p + in_stride * 3));
+
+			a0 = _mm_unpacklo_epi32(r0, r1);
+			a1 = _mm_unpackhi_epi32(r0, r1);
+			a2 = _mm_unpacklo_epi32(r2, r3);
+			a3 = _mm_unpackhi_epi32(r2, r3);
+
+			q = out + (ptrdiff_t)x * out_stride + (size_t)y * 4;
+			_mm_storeu_si128((__m128i *)q, _mm_unpacklo_epi64(a0, a2));
+			_mm_storeu_si128((__m128i *)(q + out_stride), _mm_unpackhi_epi64(a0, a2));
+			_mm_storeu_si128((__m128i *)(q + out_stride * 2), _mm_unpacklo_epi64(a1, a3));
+			_mm_storeu_si128((__m128i *)(q + out_stride * 3), _mm_unpackhi_epi64(a1, a3));
+		}
+	}
+
+	__transpose_rest(in, in_stride, out, out_stride, width, height, 4, 4);
+}
+
+/* reverses the samples of @size bytes in a vector */
+__attribute__((target("sse2")))
+static inline __m128i __sse2_reverse_vector(__m128i v, unsigned int size)
+{
+	v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+	if (size == 4)
+		return v;
+
+	v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+	if (size == 2)
+		return v;
+
+	return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+/* a vector from each end per step, both are loaded before storing, so @in and @out can be the same row */
+__attribute__((target("sse2")))
+static inline void __sse2_reverse(const unsigned char *in, unsigned char *out, unsigned int count, unsigned int size)
+{
+	unsigned int n = 16 / size, i = 0, j = count;
+	__m128i a, b;
+
+	for (; j - i >= n * 2; i += n, j -= n) {
+		a = _mm_loadu_si128((const __m128i *)(in + (size_t)i * size));
+		b = _mm_loadu_si128((const __m128i *)(in + (size_t)(j - n) * size));
+		_mm_storeu_si128((__m128i *)(out + (size_t)i * size), __sse2_reverse_vector(b, size));
+		_mm_storeu_si128((__m128i *)(out + (size_t)(j - n) * size), __sse2_reverse_vector(a, size));
+	}
+
+	/* the middle is symmetric in the row */
+	if (i < j)
+		_transform_reverse(in + (size_t)i * size, out + (size_t)i * size, j - i, size);
+}
+
+__attribute__((target("sse2")))
+static void __sse2_reverse_8(const unsigned char *in, unsigned char *out, unsigned int count)
+{
+	__sse2_reverse(in, out, count, 1);
+}
+
+__attribute__((target("sse2")))
+static void __sse2_reverse_16(const unsigned char *in, unsigned char *out, unsigned int count)
+{
+	__sse2_reverse(in, out, count, 2);
+}
+
+__attribute__((target("sse2")))
+static void __sse2_reverse_32(const unsigned char *in, unsigned char *out, unsigned int count)
+{
+	__sse2_reverse(in, out, count, 4);
+}
+
+/* the _mm_shuffle_epi8() mask and the 0xff of the missing bytes of the 4 pixels of @swizzle */
+static void __get_shuffle_masks(const transform_swizzle_s *swizzle, unsigned char *shuffle, unsigned char *fill)
+{
+	unsigned int p = 0, k = 0, i = 0;
+
+	memset(shuffle, 0x80, 16);
+	memset(fill, 0, 16);
+
+	for (p = 0; p < 4; p++) {
+		for (k = 0; k < swizzle->out_bpp; k++) {
+			i = p * swizzle->out_bpp + k;
+			if (swizzle->map[k] < 0)
+				fill[i] = 0xff;
+			else
+				shuffle[i] = (unsigned char)(p * swizzle->in_bpp + (unsigned int)swizzle->map[k]);
+		}
+	}
+}
+
+/*
+ * 4 pixels per a shuffle, 32 to 32, 24 to 32 or 32 to 24 bits.
+ * Every step loads its pixels before storing them, so @in and @out can be the same row for 32 to 32 bits.
+ */
+__attribute__((target("ssse3")))
+static void __ssse3_swizzle_row(const unsigned char *in, unsigned char *out, unsigned int width, const transform_swizzle_s *swizzle)
+{
+	unsigned char shuffle_bytes[16], fill_bytes[16];
+	__m128i shuffle, fill, v0, v1, v2, v3;
+	unsigned int i = 0;
+
+	__get_shuffle_masks(swizzle, shuffle_bytes, fill_bytes);
+	shuffle = _mm_loadu_si128((const __m128i *)shuffle_bytes);
+	fill = _mm_loadu_si128((const __m128i *)fill_bytes);
+
+	if (swizzle->in_bpp == 4 && swizzle->out_bpp == 4) {
+		for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+			v0 = _mm_loadu_si128((const __m128i *)(in + i * 4));
+			v1 = _mm_loadu_si128((const __m128i *)(in + i * 4 + 16));
+			v2 = _mm_loadu_si128((const __m128i *)(in + i * 4 + 32));
+			v3 = _mm_loadu_si128((const __m128i *)(in + i * 4 + 48));
+			_mm_storeu_si128((__m128i *)(out + i * 4), _mm_or_si128(_mm_shuffle_epi8(v0, shuffle), fill));
+			_mm_storeu_si128((__m128i *)(out + i * 4 + 16), _mm_or_si128(_mm_shuffle_epi8(v1, shuffle), fill));
+			_mm_storeu_si128((__m128i *)(out + i * 4 + 32), _mm_or_si128(_mm_shuffle_epi8(v2, shuffle), fill));
+			_mm_storeu_si128((__m128i *)(out + i * 4 + 48), _mm_or_si128(_mm_shuffle_epi8(v3, shuffle), fill));
+		}
+	} else if (swizzle->in_bpp == 3 && swizzle->out_bpp == 4) {
+		/* the 16 bytes loads of 12 bytes, the last one reads 4 bytes over the 16 pixels */
+		for (i = 0; i + SIMD_STEP + 2 <= width; i += SIMD_STEP) {
+			v0 = _mm_loadu_si128((const __m128i *)(in + i * 3));
+			v1 = _mm_loadu_si128((const __m128i *)(in + i * 3 + 12));
+			v2 = _mm_loadu_si128((const __m128i *)(in + i * 3 + 24));
+			v3 = _mm_loadu_si128((const __m128i *)(in + i * 3 + 36));
+			_mm_storeu_si128((__m128i *)(out + i * 4), _mm_or_si128(_mm_shuffle_epi8(v0, shuffle), fill));
+			_mm_storeu_si128((__m128i *)(out + i * 4 + 16), _mm_or_si128(_mm_shuffle_epi8(v1, shuffle), fill));
+			_mm_storeu_si128((__m128i *)(out + i * 4 + 32), _mm_or_si128(_mm_shuffle_epi8(v2, shuffle), fill));
+			_mm_storeu_si128((__m128i *)(out + i * 4 + 48), _mm_or_si128(_mm_shuffle_epi8(v3, shuffle), fill));
+		}
+	} else if (swizzle->in_bpp == 4 && swizzle->out_bpp == 3) {
+		/* the 12 bytes of each shuffle are joined into 3 vectors */
+		for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+			v0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + i * 4)), shuffle);
+			v1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + i * 4 + 16)), shuffle);
+			v2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + i * 4 + 32)), shuffle);
+			v3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + i * 4 + 48)), shuffle);
+			_mm_storeu_si128((__m128i *)(out + i * 3), _mm_or_si128(v0, _mm_slli_si128(v1, 12)));
+			_mm_storeu_si128((__m128i *)(out + i * 3 + 16), _mm_or_si128(_mm_srli_si128(v1, 4), _mm_slli_si128(v2, 8)));
+			_mm_storeu_si128((__m128i *)(out + i * 3 + 32), _mm_or_si128(_mm_srli_si128(v2, 8), _mm_slli_si128(v3, 4)));
+		}
+	}
+
+	if (i < width)
+		_transform_swizzle_row(in + i * swizzle->in_bpp, out + i * swizzle->out_bpp, width - i, swizzle);
+}
+
+/* 16 pixels at once in the 16 bits lanes, _mm256_packs_epi32() restores the order which _mm256_unpack*() changes in each 128 bits lane */
+__attribute__((target("avx2")))
+static inline __m128i __avx2_channel(__m256i c_lo, __m256i c_hi, __m256i de_lo, __m256i de_hi, int k0, int k1)
+{
+	__m256i k = _mm256_set1_epi32(SIMD_PAIR(k0, k1));
+	__m256i v = _mm256_packs_epi32(
+			_mm256_srai_epi32(_mm256_add_epi32(c_lo, _mm256_madd_epi16(de_lo, k)), 8),
+			_mm256_srai_epi32(_mm256_add_epi32(c_hi, _mm256_madd_epi16(de_hi, k)), 8));
+
+	return _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+__attribute__((target("avx2")))
+static void __avx2_yuv_to_rgb_row(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int uv_step, unsigned char *out, unsigned int width, transform_order_e order)
+{
+	const __m256i one = _mm256_set1_epi16(1);
+	const __m256i bias = _mm256_set1_epi16(16);
+	const __m256i coef = _mm256_set1_epi32(SIMD_PAIR(298, 128));
+	unsigned int i = 0;
+	__m128i d, e;
+	__m256i y, d16, e16, c_lo, c_hi, de_lo, de_hi;
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		y = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(py + i))), bias);
+		__sse2_load_uv(pu, pv, uv_step, i, &d, &e);
+
+		/* each chroma is for 2 pixels */
+		d16 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(d, d)), _mm_unpackhi_epi16(d, d), 1);
+		e16 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(e, e)), _mm_unpackhi_epi16(e, e), 1);
+
+		c_lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(y, one), coef);
+		c_hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(y, one), coef);
+		de_lo = _mm256_unpacklo_epi16(d16, e16);
+		de_hi = _mm256_unpackhi_epi16(d16, e16);
+
+		__sse2_store(out + (size_t)i * TRANSFORM_PIXEL_SIZE,
+			__avx2_channel(c_lo, c_hi, de_lo, de_hi, 0, 409),
+			__avx2_channel(c_lo, c_hi, de_lo, de_hi, -100, -208),
+			__avx2_channel(c_lo, c_hi, de_lo, de_hi, 516, 0),
+			order);
+	}
+
+	if (i < width)
+		_transform_yuv_to_rgb_row(py + i, pu + i / 2 * uv_step, pv + i / 2 * uv_step, uv_step, out + (size_t)i * TRANSFORM_PIXEL_SIZE, width - i, order);
+}
+
+/* the channel at the bit @shift of the 16 pixels of @p0 and @p1 as int16, _mm256_permute4x64_epi64() restores the order of the pixels */
+__attribute__((target("avx2")))
+static inline __m256i __avx2_channel_of(__m256i p0, __m256i p1, int shift)
+{
+	const __m256i mask = _mm256_set1_epi32(0xff);
+	__m256i c = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(p0, shift), mask), _mm256_and_si256(_mm256_srli_epi32(p1, shift), mask));
+
+	return _mm256_permute4x64_epi64(c, 0xd8);
+}
+
+/* see __sse2_convert() */
+__attribute__((target("avx2")))
+static inline void __avx2_convert(const unsigned char *in, const int *shift, unsigned char *py, __m256i *su, __m256i *sv)
+{
+	const __m256i one = _mm256_set1_epi16(1);
+	const __m256i round = _mm256_set1_epi16(128);
+	__m256i p0 = _mm256_loadu_si256((const __m256i *)in);
+	__m256i p1 = _mm256_loadu_si256((const __m256i *)(in + 32));
+	__m256i r = __avx2_channel_of(p0, p1, shift[0]);
+	__m256i g = __avx2_channel_of(p0, p1, shift[1]);
+	__m256i b = __avx2_channel_of(p0, p1, shift[2]);
+	__m256i y, u, v;
+
+#define AVX2_SUM(kr, kg, kb) \
+	_mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(r, _mm256_set1_epi16(kr)), _mm256_mullo_epi16(g, _mm256_set1_epi16(kg))), \
+		_mm256_add_epi16(_mm256_mullo_epi16(b, _mm256_set1_epi16(kb)), round))
+
+	y = _mm256_add_epi16(_mm256_srli_epi16(AVX2_SUM(66, 129, 25), 8), _mm256_set1_epi16(16));
+	u = _mm256_add_epi16(_mm256_srai_epi16(AVX2_SUM(-38, -74, 112), 8), round);
+	v = _mm256_add_epi16(_mm256_srai_epi16(AVX2_SUM(112, -94, -18), 8), round);
+
+#undef AVX2_SUM
+
+	_mm_storeu_si128((__m128i *)py, _mm_packus_epi16(_mm256_castsi256_si128(y), _mm256_extracti128_si256(y, 1)));
+
+	*su = _mm256_add_epi32(*su, _mm256_madd_epi16(u, one));
+	*sv = _mm256_add_epi32(*sv, _mm256_madd_epi16(v, one));
+}
+
+__attribute__((target("avx2")))
+static void __avx2_rgb_to_yuv_row(const unsigned char *row0, const unsigned char *row1, unsigned char *py0, unsigned char *py1, unsigned char *pu, unsigned char *pv, unsigned int uv_step, unsigned int width, transform_order_e order)
+{
+	const int *shift = _simd_shift_tbl[order];
+	int n = row1 ? 4 : 2;
+	unsigned int i = 0;
+	__m256i su, sv;
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		su = sv = _mm256_setzero_si256();
+
+		__avx2_convert(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE, shift, py0 + i, &su, &sv);
+		if (row1)
+			__avx2_convert(row1 + (size_t)i * TRANSFORM_PIXEL_SIZE, shift, py1 + i, &su, &sv);
+
+		__sse2_store_uv(pu, pv, uv_step, i,
+			__sse2_average(_mm256_castsi256_si128(su), _mm256_extracti128_si256(su, 1), n),
+			__sse2_average(_mm256_castsi256_si128(sv), _mm256_extracti128_si256(sv, 1), n));
+	}
+
+	if (i < width)
+		_transform_rgb_to_yuv_row(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE, row1 ? row1 + (size_t)i * TRANSFORM_PIXEL_SIZE : NULL,
+			py0 + i, py1 ? py1 + i : NULL, pu + i / 2 * uv_step, pv + i / 2 * uv_step, uv_step, width - i, order);
+}
+
+#endif /* SIMD_X86 */
+
+#ifdef SIMD_NEON
+
+/* 8 pixels of the int16 y - 16, u - 128 and v - 128 into a channel, see __yuv_to_rgb() */
+static inline uint8x8_t __neon_channel(int16x8_t y, int16x8_t d, int16x8_t e, int16_t kd, int16_t ke)
+{
+	int32x4_t lo = vmlal_n_s16(vmlal_n_s16(vmull_n_s16(vget_low_s16(y), 298), vget_low_s16(d), kd), vget_low_s16(e), ke);
+	int32x4_t hi = vmlal_n_s16(vmlal_n_s16(vmull_n_s16(vget_high_s16(y), 298), vget_high_s16(d), kd), vget_high_s16(e), ke);
+
+	lo = vaddq_s32(lo, vdupq_n_s32(128));
+	hi = vaddq_s32(hi, vdupq_n_s32(128));
+
+	return vqmovun_s16(vcombine_s16(vqshrn_n_s32(lo, 8), vqshrn_n_s32(hi, 8)));
+}
+
+static inline void __neon_convert(const uint8x8_t y8, uint8x8_t u8, uint8x8_t v8, unsigned char *out, transform_order_e order)
+{
+	int16x8_t y = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y8)), vdupq_n_s16(16));
+	int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u8)), vdupq_n_s16(128));
+	int16x8_t e = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v8)), vdupq_n_s16(128));
+	uint8x8_t r = __neon_channel(y, d, e, 0, 409);
+	uint8x8_t g = __neon_channel(y, d, e, -100, -208);
+	uint8x8_t b = __neon_channel(y, d, e, 516, 0);
+	uint8x8_t a = vdup_n_u8(0xff);
+	uint8x8x4_t px;
+
+	if (order == TRANSFORM_ORDER_BGRA) {
+		px.val[0] = b;
+		px.val[1] = g;
+		px.val[2] = r;
+		px.val[3] = a;
+	} else if (order == TRANSFORM_ORDER_ARGB) {
+		px.val[0] = a;
+		px.val[1] = r;
+		px.val[2] = g;
+		px.val[3] = b;
+	} else {
+		px.val[0] = r;
+		px.val[1] = g;
+		px.val[2] = b;
+		px.val[3] = a;
+	}
+
+	vst4_u8(out, px);
+}
+
+static void __neon_yuv_to_rgb_row(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int uv_step, unsigned char *out, unsigned int width, transform_order_e order)
+{
+	unsigned int i = 0;
+	uint8x16_t y;
+	uint8x8_t u, v;
+	uint8x8x2_t uv, du, dv;
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		y = vld1q_u8(py + i);
+
+		if (uv_step == 1) {
+			u = vld1_u8(pu + i / 2);
+			v = vld1_u8(pv + i / 2);
+		} else {
+			uv = vld2_u8(((pu < pv) ? pu : pv) + i);
+			u = (pu < pv) ? uv.val[0] : uv.val[1];
+			v = (pu < pv) ? uv.val[1] : uv.val[0];
+		}
+
+		/* each chroma is for 2 pixels */
+		du = vzip_u8(u, u);
+		dv = vzip_u8(v, v);
+
+		__neon_convert(vget_low_u8(y), du.val[0], dv.val[0], out + (size_t)i * TRANSFORM_PIXEL_SIZE, order);
+		__neon_convert(vget_high_u8(y), du.val[1], dv.val[1], out + (size_t)(i + 8) * TRANSFORM_PIXEL_SIZE, order);
+	}
+
+	if (i < width)
+		_transform_yuv_to_rgb_row(py + i, pu + i / 2 * uv_step, pv + i / 2 * uv_step, uv_step, out + (size_t)i * TRANSFORM_PIXEL_SIZE, width - i, order);
+}
+
+/* the offsets of R, G and B in the pixel of each transform_order_e */
+static const unsigned int _simd_offset_tbl[][3] = {
+	{ 0, 1, 2 },		/* TRANSFORM_ORDER_RGBA */
+	{ 2, 1, 0 },		/* TRANSFORM_ORDER_BGRA */
+	{ 1, 2, 3 },		/* TRANSFORM_ORDER_ARGB */
+};
+
+/* 8 pixels of R, G and B into Y and the int32 sums of the chroma of each 2 pixels, see __rgb_to_yuv() */
+static inline uint8x8_t __neon_rgb_to_yuv(uint8x8_t r8, uint8x8_t g8, uint8x8_t b8, int32x4_t *su, int32x4_t *sv)
+{
+	int16x8_t r = vreinterpretq_s16_u16(vmovl_u8(r8));
+	int16x8_t g = vreinterpretq_s16_u16(vmovl_u8(g8));
+	int16x8_t b = vreinterpretq_s16_u16(vmovl_u8(b8));
+	uint16x8_t y = vmlal_u8(vmlal_u8(vmull_u8(r8, vdup_n_u8(66)), g8, vdup_n_u8(129)), b8, vdup_n_u8(25));
+	int16x8_t u = vmlsq_n_s16(vmlsq_n_s16(vmulq_n_s16(b, 112), r, 38), g, 74);
+	int16x8_t v = vmlsq_n_s16(vmlsq_n_s16(vmulq_n_s16(r, 112), g, 94), b, 18);
+
+	/* the rounding shifts add 128 before shifting */
+	u = vaddq_s16(vrshrq_n_s16(u, 8), vdupq_n_s16(128));
+	v = vaddq_s16(vrshrq_n_s16(v, 8), vdupq_n_s16(128));
+
+	*su = vpadalq_s16(*su, u);
+	*sv = vpadalq_s16(*sv, v);
+
+	return vadd_u8(vrshrn_n_u16(y, 8), vdup_n_u8(16));
+}
+
+static inline void __neon_convert_rgb(const unsigned char *in, const unsigned int *idx, unsigned char *py, int32x4_t *su, int32x4_t *sv)
+{
+	uint8x16x4_t px = vld4q_u8(in);
+
+	vst1_u8(py, __neon_rgb_to_yuv(vget_low_u8(px.val[idx[0]]), vget_low_u8(px.val[idx[1]]), vget_low_u8(px.val[idx[2]]), &su[0], &sv[0]));
+	vst1_u8(py + 8, __neon_rgb_to_yuv(vget_high_u8(px.val[idx[0]]), vget_high_u8(px.val[idx[1]]), vget_high_u8(px.val[idx[2]]), &su[1], &sv[1]));
+}
+
+/* the rounded averages of the 8 sums of 4 or 2 chroma */
+static inline uint8x8_t __neon_average(const int32x4_t *s, bool four)
+{
+	if (four)
+		return vqmovun_s16(vcombine_s16(vmovn_s32(vrshrq_n_s32(s[0], 2)), vmovn_s32(vrshrq_n_s32(s[1], 2))));
+
+	return vqmovun_s16(vcombine_s16(vmovn_s32(vrshrq_n_s32(s[0], 1)), vmovn_s32(vrshrq_n_s32(s[1], 1))));
+}
+
+static void __neon_rgb_to_yuv_row(const unsigned char *row0, const unsigned char *row1, unsigned char *py0, unsigned char *py1, unsigned char *pu, unsigned char *pv, unsigned int uv_step, unsigned int width, transform_order_e order)
+{
+	const unsigned int *idx = _simd_offset_tbl[order];
+	unsigned int i = 0;
+	int32x4_t su[2], sv[2];
+	uint8x8_t u, v;
+	uint8x8x2_t uv;
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		su[0] = su[1] = sv[0] = sv[1] = vdupq_n_s32(0);
+
+		__neon_convert_rgb(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE, idx, py0 + i, su, sv);
+		if (row1)
+			__neon_convert_rgb(row1 + (size_t)i * TRANSFORM_PIXEL_SIZE, idx, py1 + i, su, sv);
+
+		u = __neon_average(su, row1 != NULL);
+		v = __neon_average(sv, row1 != NULL);
+
+		if (uv_step == 1) {
+			vst1_u8(pu + i / 2, u);
+			vst1_u8(pv + i / 2, v);
+		} else {
+			uv.val[0] = (pu < pv) ? u : v;
+			uv.val[1] = (pu < pv) ? v : u;
+			vst2_u8(((pu < pv) ? pu : pv) + i, uv);
+		}
+	}
+
+	if (i < width)
+		_transform_rgb_to_yuv_row(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE, row1 ? row1 + (size_t)i * TRANSFORM_PIXEL_SIZE : NULL,
+			py0 + i, py1 ? py1 + i : NULL, pu + i / 2 * uv_step, pv + i / 2 * uv_step, uv_step, width - i, order);
+}
+
+static void __neon_split_uv(const unsigned char *uv, unsigned char *u, unsigned char *v, unsigned int count)
+{
+	unsigned int i = 0;
+	uint8x16x2_t c;
+
+	for (i = 0; i + SIMD_STEP <= count; i += SIMD_STEP) {
+		c = vld2q_u8(uv + i * 2);
+		vst1q_u8(u + i, c.val[0]);
+		vst1q_u8(v + i, c.val[1]);
+	}
+
+	if (i < count)
+		_transform_split_uv(uv + i * 2, u + i, v + i, count - i);
+}
+
+static void __neon_merge_uv(const unsigned char *u, const unsigned char *v, unsigned char *uv, unsigned int count)
+{
+	unsigned int i = 0;
+	uint8x16x2_t c;
+
+	for (i = 0; i + SIMD_STEP <= count; i += SIMD_STEP) {
+		c.val[0] = vld1q_u8(u + i);
+		c.val[1] = vld1q_u8(v + i);
+		vst2q_u8(uv + i * 2, c);
+	}
+
+	if (i < count)
+		_transform_merge_uv(u + i, v + i, uv + i * 2, count - i);
+}
+
+/* the 4 bytes macro pixels are Y0 U Y1 V for YUYV and U Y0 V Y1 for UYVY */
+static void __neon_split_packed(const unsigned char *in, unsigned int y_idx, unsigned char *py, unsigned char *pu, unsigned char *pv, unsigned int width)
+{
+	unsigned int i = 0;
+	uint8x16x4_t m;
+	uint8x16x2_t y;
+
+	for (i = 0; i + SIMD_STEP * 2 <= width; i += SIMD_STEP * 2) {
+		m = vld4q_u8(in + i * 2);
+		y.val[0] = m.val[y_idx];
+		y.val[1] = m.val[y_idx + 2];
+		vst2q_u8(py + i, y);
+		vst1q_u8(pu + i / 2, m.val[y_idx ^ 1]);
+		vst1q_u8(pv + i / 2, m.val[(y_idx ^ 1) + 2]);
+	}
+
+	if (i < width)
+		_transform_split_packed(in + i * 2, y_idx, py + i, pu + i / 2, pv + i / 2, width - i);
+}
+
+static void __neon_merge_packed(const unsigned char *py, const unsigned char *pu, const unsigned char *pv, unsigned int y_idx, unsigned char *out, unsigned int width)
+{
+	unsigned int i = 0;
+	uint8x16x4_t m;
+	uint8x16x2_t y;
+
+	for (i = 0; i + SIMD_STEP * 2 <= width; i += SIMD_STEP * 2) {
+		y = vld2q_u8(py + i);
+		m.val[y_idx] = y.val[0];
+		m.val[y_idx + 2] = y.val[1];
+		m.val[y_idx ^ 1] = vld1q_u8(pu + i / 2);
+		m.val[(y_idx ^ 1) + 2] = vld1q_u8(pv + i / 2);
+		vst4q_u8(out + i * 2, m);
+	}
+
+	if (i < width)
+		_transform_merge_packed(py + i, pu + i / 2, pv + i / 2, y_idx, out + i * 2, width - i);
+}
+
+/* vrhaddq_u8() is (a + b + 1) >> 1 */
+static void __neon_average_rows(const unsigned char *a, const unsigned char *b, unsigned char *out, unsigned int count)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i + SIMD_STEP <= count; i += SIMD_STEP)
+		vst1q_u8(out + i, vrhaddq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+
+	if (i < count)
+		_transform_average(a + i, b + i, out + i, count - i);
+}
+
+/* 16 pixels per step, the pixels are loaded before storing them, so @in and @out can be the same row for 32 to 32 bits */
+static void __neon_swizzle_row(const unsigned char *in, unsigned char *out, unsigned int width, const transform_swizzle_s *swizzle)
+{
+	const uint8x16_t fill = vdupq_n_u8(0xff);
+	unsigned int i = 0, k = 0;
+	uint8x16x4_t p4, o4;
+	uint8x16x3_t p3, o3;
+
+	if (swizzle->in_bpp == 4 && swizzle->out_bpp == 4) {
+		for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+			p4 = vld4q_u8(in + i * 4);
+			for (k = 0; k < 4; k++)
+				o4.val[k] = (swizzle->map[k] < 0) ? fill : p4.val[swizzle->map[k]];
+			vst4q_u8(out + i * 4, o4);
+		}
+	} else if (swizzle->in_bpp == 3 && swizzle->out_bpp == 4) {
+		for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+			p3 = vld3q_u8(in + i * 3);
+			for (k = 0; k < 4; k++)
+				o4.val[k] = (swizzle->map[k] < 0) ? fill : p3.val[swizzle->map[k]];
+			vst4q_u8(out + i * 4, o4);
+		}
+	} else if (swizzle->in_bpp == 4 && swizzle->out_bpp == 3) {
+		for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+			p4 = vld4q_u8(in + i * 4);
+			for (k = 0; k < 3; k++)
+				o3.val[k] = p4.val[swizzle->map[k]];
+			vst3q_u8(out + i * 3, o3);
+		}
+	}
+
+	if (i < width)
+		_transform_swizzle_row(in + i * swizzle->in_bpp, out + i * swizzle->out_bpp, width - i, swizzle);
+}
+
+/* expands the 8 RGB565 pixels of @c, see _transform_unpack_rgb565_row() */
+static inline void __neon_unpack_rgb565(uint16x8_t c, uint8x8_t *r, uint8x8_t *g, uint8x8_t *b)
+{
+	uint8x8_t t = vmovn_u16(vshrq_n_u16(c, 11));
+
+	*r = vorr_u8(vshl_n_u8(t, 3), vshr_n_u8(t, 2));
+	t = vand_u8(vmovn_u16(vshrq_n_u16(c, 5)), vdup_n_u8(0x3f));
+	*g = vorr_u8(vshl_n_u8(t, 2), vshr_n_u8(t, 4));
+	t = vand_u8(vmovn_u16(c), vdup_n_u8(0x1f));
+	*b = vorr_u8(vshl_n_u8(t, 3), vshr_n_u8(t, 2));
+}
+
+static void __neon_unpack_rgb565_row(const unsigned char *in, unsigned char *out, unsigned int width, transform_order_e order)
+{
+	const unsigned int *idx = _simd_offset_tbl[order];
+	unsigned int i = 0;
+	uint8x8_t r0, g0, b0, r1, g1, b1;
+	uint8x16x4_t px;
+
+	px.val[(order == TRANSFORM_ORDER_ARGB) ? 0 : 3] = vdupq_n_u8(0xff);
+
+	/* the bytes are loaded for the rows of the odd addresses */
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		__neon_unpack_rgb565(vreinterpretq_u16_u8(vld1q_u8(in + i * 2)), &r0, &g0, &b0);
+		__neon_unpack_rgb565(vreinterpretq_u16_u8(vld1q_u8(in + i * 2 + 16)), &r1, &g1, &b1);
+		px.val[idx[0]] = vcombine_u8(r0, r1);
+		px.val[idx[1]] = vcombine_u8(g0, g1);
+		px.val[idx[2]] = vcombine_u8(b0, b1);
+		vst4q_u8(out + (size_t)i * TRANSFORM_PIXEL_SIZE, px);
+	}
+
+	if (i < width)
+		_transform_unpack_rgb565_row(in + i * 2, out + (size_t)i * TRANSFORM_PIXEL_SIZE, width - i, order);
+}
+
+static inline uint16x8_t __neon_pack_rgb565(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+	return vorrq_u16(vorrq_u16(vshlq_n_u16(vmovl_u8(vshr_n_u8(r, 3)), 11), vshlq_n_u16(vmovl_u8(vshr_n_u8(g, 2)), 5)), vmovl_u8(vshr_n_u8(b, 3)));
+}
+
+/* the additions of the dither wrap around in uint8, but the results after the subtractions fit in it */
+static void __neon_pack_rgb565_row(const unsigned char *in, unsigned char *out, unsigned int width, transform_order_e order, const unsigned char *dither)
+{
+	const unsigned int *idx = _simd_offset_tbl[order];
+	unsigned char thresholds[2][SIMD_STEP];
+	unsigned int i = 0;
+	uint8x16_t r, g, b;
+	uint8x16_t dr = vdupq_n_u8(0), dg = vdupq_n_u8(0);
+	uint8x16x4_t px;
+
+	if (dither) {
+		for (i = 0; i < SIMD_STEP; i++) {
+			thresholds[0][i] = dither[i & 3] >> 1;
+			thresholds[1][i] = dither[i & 3] >> 2;
+		}
+		dr = vld1q_u8(thresholds[0]);
+		dg = vld1q_u8(thresholds[1]);
+	}
+
+	for (i = 0; i + SIMD_STEP <= width; i += SIMD_STEP) {
+		px = vld4q_u8(in + (size_t)i * TRANSFORM_PIXEL_SIZE);
+		r = px.val[idx[0]];
+		g = px.val[idx[1]];
+		b = px.val[idx[2]];
+
+		if (dither) {
+			r = vsubq_u8(vaddq_u8(r, dr), vshrq_n_u8(r, 5));
+			g = vsubq_u8(vaddq_u8(g, dg), vshrq_n_u8(g, 6));
+			b = vsubq_u8(vaddq_u8(b, dr), vshrq_n_u8(b, 5));
+		}
+
+		vst1q_u8(out + i * 2, vreinterpretq_u8_u16(__neon_pack_rgb565(vget_low_u8(r), vget_low_u8(g), vget_low_u8(b))));
+		vst1q_u8(out + i * 2 + 16, vreinterpretq_u8_u16(__neon_pack_rgb565(vget_high_u8(r), vget_high_u8(g), vget_high_u8(b))));
+	}
+
+	if (i < width)
+		_transform_pack_rgb565_row(in + (size_t)i * TRANSFORM_PIXEL_SIZE, out + i * 2, width - i, order, dither);
+}
+
+/* the 4 channels of each tap are widened and multiplied at once */
+static void __neon_resample_h_row(const unsigned char *in, unsigned char *out, unsigned int width, const unsigned int *first, const unsigned int *count, const short *weights, unsigned int taps)
+{
+	const unsigned char *p = NULL;
+	const short *w = NULL;
+	unsigned int i = 0, k = 0;
+	uint32_t pixel = 0;
+	int32x4_t acc;
+	int16x4_t px;
+	uint8x8_t res;
+
+	for (i = 0; i < width; i++) {
+		p = in + (size_t)first[i] * TRANSFORM_PIXEL_SIZE;
+		w = weights + (size_t)i * taps;
+		acc = vdupq_n_s32(1 << (TRANSFORM_FILTER_BITS - 1));
+
+		for (k = 0; k < count[i]; k++) {
+			memcpy(&pixel, p + k * TRANSFORM_PIXEL_SIZE, TRANSFORM_PIXEL_SIZE);
+			px = vget_low_s16(vreinterpretq_s16_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(pixel)))));
+			acc = vmlal_n_s16(acc, px, w[k]);
+		}
+
+		res = vqmovun_s16(vcombine_s16(vqshrn_n_s32(acc, TRANSFORM_FILTER_BITS), vdup_n_s16(0)));
+		pixel = vget_lane_u32(vreinterpret_u32_u8(res), 0);
+		memcpy(out + (size_t)i * TRANSFORM_PIXEL_SIZE, &pixel, TRANSFORM_PIXEL_SIZE);
+	}
+}
+
+/* 16 bytes per step, the last step overlaps the previous one instead of the scalar tail */
+static void __neon_resample_v_row(const unsigned char *const *rows, const short *weights, unsigned int count, unsigned char *out, unsigned int size)
+{
+	unsigned int i = 0, k = 0;
+	int32x4_t acc0, acc1, acc2, acc3;
+	int16x8_t lo, hi;
+	uint8x16_t a;
+
+	if (size < SIMD_STEP) {
+		_transform_resample_v_row(rows, weights, count, out, size);
+		return;
+	}
+
+	for (i = 0; i < size; i += SIMD_STEP) {
+		if (i + SIMD_STEP > size)
+			i = size - SIMD_STEP;
+
+		acc0 = acc1 = acc2 = acc3 = vdupq_n_s32(1 << (TRANSFORM_FILTER_BITS - 1));
+
+		for (k = 0; k < count; k++) {
+			a = vld1q_u8(rows[k] + i);
+			lo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(a)));
+			hi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(a)));
+			acc0 = vmlal_n_s16(acc0, vget_low_s16(lo), weights[k]);
+			acc1 = vmlal_n_s16(acc1, vget_high_s16(lo), weights[k]);
+			acc2 = vmlal_n_s16(acc2, vget_low_s16(hi), weights[k]);
+			acc3 = vmlal_n_s16(acc3, vget_high_s16(hi), weights[k]);
+		}
+
+		vst1q_u8(out + i, vcombine_u8(vqmovun_s16(vcombine_s16(vqshrn_n_s32(acc0, TRANSFORM_FILTER_BITS), vqshrn_n_s32(acc1, TRANSFORM_FILTER_BITS))),
+			vqmovun_s16(vcombine_s16(vqshrn_n_s32(acc2, TRANSFORM_FILTER_BITS), vqshrn_n_s32(acc3, TRANSFORM_FILTER_BITS)))));
+	}
+}
+
+/* 8 pixels of each row into 4 pixels per step, vld2q_u32() splits the even and the odd pixels */
+static void __neon_halve_row(const unsigned char *row0, const unsigned char *row1, unsigned char *out, unsigned int width)
+{
+	unsigned int i = 0;
+	uint32x4x2_t a, b;
+	uint16x8_t lo, hi;
+
+	for (i = 0; i + 8 <= width; i += 8) {
+		a = vld2q_u32((const uint32_t *)(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE));
+		b = vld2q_u32((const uint32_t *)(row1 + (size_t)i * TRANSFORM_PIXEL_SIZE));
+
+		lo = vaddl_u8(vget_low_u8(vreinterpretq_u8_u32(a.val[0])), vget_low_u8(vreinterpretq_u8_u32(a.val[1])));
+		hi = vaddl_u8(vget_high_u8(vreinterpretq_u8_u32(a.val[0])), vget_high_u8(vreinterpretq_u8_u32(a.val[1])));
+		lo = vaddq_u16(lo, vaddl_u8(vget_low_u8(vreinterpretq_u8_u32(b.val[0])), vget_low_u8(vreinterpretq_u8_u32(b.val[1]))));
+		hi = vaddq_u16(hi, vaddl_u8(vget_high_u8(vreinterpretq_u8_u32(b.val[0])), vget_high_u8(vreinterpretq_u8_u32(b.val[1]))));
+
+		vst1q_u8(out + (size_t)(i / 2) * TRANSFORM_PIXEL_SIZE, vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2)));
+	}
+
+	if (i < width)
+		_transform_halve_row(row0 + (size_t)i * TRANSFORM_PIXEL_SIZE, row1 + (size_t)i * TRANSFORM_PIXEL_SIZE, out + (size_t)(i / 2) * TRANSFORM_PIXEL_SIZE, width - i);
+}
+
+/* 8x8 bytes per block by vtrn of 8, 16 and 32 bits */
+static void __neon_transpose_8(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height)
+{
+	unsigned int x = 0, y = 0, k = 0;
+	const unsigned char *p = NULL;
+	unsigned char *q = NULL;
+	uint8x8_t r[8];
+	uint8x8x2_t t0, t1, t2, t3;
+	uint16x4x2_t u0, u1, u2, u3;
+	uint32x2x2_t v[4];
+
+	for (x = 0; x + 8 <= width; x += 8) {
+		for (y = 0; y + 8 <= height; y += 8) {
+			p = in + (ptrdiff_t)y * in_stride + x;
+			for (k = 0; k < 8; k++)
+				r[k] = vld1_u8(p + (ptrdiff_t)k * in_stride);
+
+			t0 = vtrn_u8(r[0], r[1]);
+			t1 = vtrn_u8(r[2], r[3]);
+			t2 = vtrn_u8(r[4], r[5]);
+			t3 = vtrn_u8(r[6], r[7]);
+			u0 = vtrn_u16(vreinterpret_u16_u8(t0.val[0]), vreinterpret_u16_u8(t1.val[0]));
+			u1 = vtrn_u16(vreinterpret_u16_u8(t0.val[1]), vreinterpret_u16_u8(t1.val[1]));
+			u2 = vtrn_u16(vreinterpret_u16_u8(t2.val[0]), vreinterpret_u16_u8(t3.val[0]));
+			u3 = vtrn_u16(vreinterpret_u16_u8(t2.val[1]), vreinterpret_u16_u8(t3.val[1]));
+
+			/* the output rows k and k + 4 */
+			v[0] = vtrn_u32(vreinterpret_u32_u16(u0.val[0]), vreinterpret_u32_u16(u2.val[0]));
+			v[1] = vtrn_u32(vreinterpret_u32_u16(u1.val[0]), vreinterpret_u32_u16(u3.val[0]));
+			v[2] = vtrn_u32(vreinterpret_u32_u16(u0.val[1]), vreinterpret_u32_u16(u2.val[1]));
+			v[3] = vtrn_u32(vreinterpret_u32_u16(u1.val[1]), vreinterpret_u32_u16(u3.val[1]));
+
+			q = out + (ptrdiff_t)x * out_stride + y;
+			for (k = 0; k < 4; k++) {
+				vst1_u8(q + (ptrdiff_t)k * out_stride, vreinterpret_u8_u32(v[k].val[0]));
+				vst1_u8(q + (ptrdiff_t)(k + 4) * out_stride, vreinterpret_u8_u32(v[k].val[1]));
+			}
+		}
+	}
+
+	__transpose_rest(in, in_stride, out, out_stride, width, height, 1, 8);
+}
+
+/* 4x4 of 2 bytes per block */
+static void __neon_transpose_16(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height)
+{
+	unsigned int x = 0, y = 0;
+	const unsigned char *p = NULL;
+	unsigned char *q = NULL;
+	uint16x4x2_t t0, t1;
+	uint32x2x2_t v0, v1;
+
+	for (x = 0; x + 4 <= width; x += 4) {
+		for (y = 0; y + 4 <= height; y += 4) {
+			p = in + (ptrdiff_t)y * in_stride + (size_t)x * 2;
+			t0 = vtrn_u16(vreinterpret_u16_u8(vld1_u8(p)), vreinterpret_u16_u8(vld1_u8(p + in_stride)));
+			t1 = vtrn_u16(vreinterpret_u16_u8(vld1_u8(p + in_stride * 2)), vreinterpret_u16_u8(vld1_u8(p + in_stride * 3)));
+			v0 = vtrn_u32(vreinterpret_u32_u16(t0.val[0]), vreinterpret_u32_u16(t1.val[0]));
+			v1 = vtrn_u32(vreinterpret_u32_u16(t0.val[1]), vreinterpret_u32_u16(t1.val[1]));
+
+			q = out + (ptrdiff_t)x * out_stride + (size_t)y * 2;
+			vst1_u8(q, vreinterpret_u8_u32(v0.val[0]));
+			vst1_u8(q + out_stride, vreinterpret_u8_u32(v1.val[0]));
+			vst1_u8(q + out_stride * 2, vreinterpret_u8_u32(v0.val[1]));
+			vst1_u8(q + out_stride * 3, vreinterpret_u8_u32(v1.val[1]));
+		}
+	}
+
+	__transpose_rest(in, in_stride, out, out_stride, width, height, 2, 4);
+}
+
+/* 4x4 of 4 bytes per block */
+static void __neon_transpose_32(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height)
+{
+	unsigned int x = 0, y = 0;
+	const unsigned char *p = NULL;
+	unsigned char *q = NULL;
+	uint32x4x2_t t0, t1;
+
+	for (x = 0; x + 4 <= width; x += 4) {
+		for (y = 0; y + 4 <= height; y += 4) {
+			p = in + (ptrdiff_t)y * in_stride + (size_t)x * 4;
+			t0 = vtrnq_u32(vreinterpretq_u32_u8(vld1q_u8(p)), vreinterpretq_u32_u8(vld1q_u8(p + in_stride)));
+			t1 = vtrnq_u32(vreinterpretq_u32_u8(vld1q_u8(p + in_stride * 2)), vreinterpretq_u32_u8(vld1q_u8(p + in_stride * 3)));
+
+			q = out + (ptrdiff_t)x * out_stride + (size_t)y * 4;
+			vst1q_u8(q, vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(t0.val[0]), vget_low_u32(t1.val[0]))));
+			vst1q_u8(q + out_stride, vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(t0.val[1]), vget_low_u32(t1.val[1]))));
+			vst1q_u8(q + out_stride * 2, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(t0.val[0]), vget_high_u32(t1.val[0]))));
+			vst1q_u8(q + out_stride * 3, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(t0.val[1]), vget_high_u32(t1.val[1]))));
+		}
+	}
+
+	__transpose_rest(in, in_stride, out, out_stride, width, height, 4, 4);
+}
+
+/* reverses the samples of @size bytes in a vector, vrev64 reverses the halves and they are swapped */
+static inline uint8x16_t __neon_reverse_vector(uint8x16_t v, unsigned int size)
+{
+	if (size == 4)
+		v = vreinterpretq_u8_u32(vrev64q_u32(vreinterpretq_u32_u8(v)));
+	else if (size == 2)
+		v = vreinterpretq_u8_u16(vrev64q_u16(vreinterpretq_u16_u8(v)));
+	else
+		v = vrev64q_u8(v);
+
+	return vcombine_u8(vget_high_u8(v), vget_low_u8(v));
+}
+
+/* a vector from each end per step, both are loaded before storing, so @in and @out can be the same row */
+static inline void __neon_reverse(const unsigned char *in, unsigned char *out, unsigned int count, unsigned int size)
+{
+	unsigned int n = 16 / size, i = 0, j = count;
+	uint8x16_t a, b;
+
+	for (; j - i >= n * 2; i += n, j -= n) {
+		a = vld1q_u8(in + (size_t)i * size);
+		b = vld1q_u8(in + (size_t)(j - n) * size);
+		vst1q_u8(out + (size_t)i * size, __neon_reverse_vector(b, size));
+		vst1q_u8(out + (size_t)(j - n) * size, __neon_reverse_vector(a, size));
+	}
+
+	/* the middle is symmetric in the row */
+	if (i < j)
+		_transform_reverse(in + (size_t)i * size, out + (size_t)i * size, j - i, size);
+}
+
+static void __neon_reverse_8(const unsigned char *in, unsigned char *out, unsigned int count)
+{
+	__neon_reverse(in, out, count, 1);
+}
+
+static void __neon_reverse_16(const unsigned char *in, unsigned char *out, unsigned int count)
+{
+	__neon_reverse(in, out, count, 2);
+}
+
+static void __neon_reverse_32(const unsigned char *in, unsigned char *out, unsigned int count)
+{
+	__neon_reverse(in, out, count, 4);
+}
+
+#endif /* SIMD_NEON */
+
+static gsize __select_yuv_to_rgb_func(void)
+{
+#ifdef SIMD_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx2")) {
+		image_util_debug("AVX2 yuv to rgb");
+		return (gsize)__avx2_yuv_to_rgb_row;
+	}
+
+	if (__builtin_cpu_supports("sse2")) {
+		image_util_debug("SSE2 yuv to rgb");
+		return (gsize)__sse2_yuv_to_rgb_row;
+	}
+#endif
+
+#ifdef SIMD_NEON
+	image_util_debug("NEON yuv to rgb");
+	return (gsize)__neon_yuv_to_rgb_row;
+#endif
+
+	image_util_debug("scalar yuv to rgb");
+	return (gsize)_transform_yuv_to_rgb_row;
+}
+
+transform_yuv_to_rgb_func _transform_get_yuv_to_rgb_func(void)
+{
+	static gsize func = 0;
+
+	if (g_once_init_enter(&func))
+		g_once_init_leave(&func, __select_yuv_to_rgb_func());
+
+	return (transform_yuv_to_rgb_func)func;
+}
+
+static gsize __select_rgb_to_yuv_func(void)
+{
+#ifdef SIMD_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx2")) {
+		image_util_debug("AVX2 rgb to yuv");
+		return (gsize)__avx2_rgb_to_yuv_row;
+	}
+
+	if (__builtin_cpu_supports("sse2")) {
+		image_util_debug("SSE2 rgb to yuv");
+		return (gsize)__sse2_rgb_to_yuv_row;
+	}
+#endif
+
+#ifdef SIMD_NEON
+	image_util_debug("NEON rgb to yuv");
+	return (gsize)__neon_rgb_to_yuv_row;
+#endif
+
+	image_util_debug("scalar rgb to yuv");
+	return (gsize)_transform_rgb_to_yuv_row;
+}
+
+transform_rgb_to_yuv_func _transform_get_rgb_to_yuv_func(void)
+{
+	static gsize func = 0;
+
+	if (g_once_init_enter(&func))
+		g_once_init_leave(&func, __select_rgb_to_yuv_func());
+
+	return (transform_rgb_to_yuv_func)func;
+}
+
+#ifdef SIMD_X86
+static const transform_yuv_kernels_s _simd_sse2_yuv_kernels = {
+	__sse2_split_uv,
+	__sse2_merge_uv,
+	__sse2_split_packed,
+	__sse2_merge_packed,
+	__sse2_average_rows,
+};
+#endif
+
+#ifdef SIMD_NEON
+static const transform_yuv_kernels_s _simd_neon_yuv_kernels = {
+	__neon_split_uv,
+	__neon_merge_uv,
+	__neon_split_packed,
+	__neon_merge_packed,
+	__neon_average_rows,
+};
+#endif
+
+static const transform_yuv_kernels_s _simd_scalar_yuv_kernels = {
+	_transform_split_uv,
+	_transform_merge_uv,
+	_transform_split_packed,
+	_transform_merge_packed,
+	_transform_average,
+};
+
+/* the shuffles are bound by the memory rather than by the width of the vectors, so there is no AVX2 variant */
+static gsize __select_yuv_kernels(void)
+{
+#ifdef SIMD_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse2")) {
+		image_util_debug("SSE2 yuv kernels");
+		return (gsize)&_simd_sse2_yuv_kernels;
+	}
+#endif
+
+#ifdef SIMD_NEON
+	image_util_debug("NEON yuv kernels");
+	return (gsize)&_simd_neon_yuv_kernels;
+#endif
+
+	image_util_debug("scalar yuv kernels");
+	return (gsize)&_simd_scalar_yuv_kernels;
+}
+
+const transform_yuv_kernels_s *_transform_get_yuv_kernels(void)
+{
+	static gsize kernels = 0;
+
+	if (g_once_init_enter(&kernels))
+		g_once_init_leave(&kernels, __select_yuv_kernels());
+
+	return (const transform_yuv_kernels_s *)kernels;
+}
+
+static gsize __select_swizzle_func(void)
+{
+#ifdef SIMD_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("ssse3")) {
+		image_util_debug("SSSE3 swizzle");
+		return (gsize)__ssse3_swizzle_row;
+	}
+#endif
+
+#ifdef SIMD_NEON
+	image_util_debug("NEON swizzle");
+	return (gsize)__neon_swizzle_row;
+#endif
+
+	image_util_debug("scalar swizzle");
+	return (gsize)_transform_swizzle_row;
+}
+
+transform_swizzle_func _transform_get_swizzle_func(void)
+{
+	static gsize func = 0;
+
+	if (g_once_init_enter(&func))
+		g_once_init_leave(&func, __select_swizzle_func());
+
+	return (transform_swizzle_func)func;
+}
+
+#ifdef SIMD_X86
+static const transform_rgb565_kernels_s _simd_sse2_rgb565_kernels = {
+	__sse2_unpack_rgb565_row,
+	__sse2_pack_rgb565_row,
+};
+#endif
+
+#ifdef SIMD_NEON
+static const transform_rgb565_kernels_s _simd_neon_rgb565_kernels = {
+	__neon_unpack_rgb565_row,
+	__neon_pack_rgb565_row,
+};
+#endif
+
+static const transform_rgb565_kernels_s _simd_scalar_rgb565_kernels = {
+	_transform_unpack_rgb565_row,
+	_transform_pack_rgb565_row,
+};
+
+static gsize __select_rgb565_kernels(void)
+{
+#ifdef SIMD_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse2")) {
+		image_util_debug("SSE2 rgb565 kernels");
+		return (gsize)&_simd_sse2_rgb565_kernels;
+	}
+#endif
+
+#ifdef SIMD_NEON
+	image_util_debug("NEON rgb565 kernels");
+	return (gsize)&_simd_neon_rgb565_kernels;
+#endif
+
+	image_util_debug("scalar rgb565 kernels");
+	return (gsize)&_simd_scalar_rgb565_kernels;
+}
+
+const transform_rgb565_kernels_s *_transform_get_rgb565_kernels(void)
+{
+	static gsize kernels = 0;
+
+	if (g_once_init_enter(&kernels))
+		g_once_init_leave(&kernels, __select_rgb565_kernels());
+
+	return (const transform_rgb565_kernels_s *)kernels;
+}
+
+#ifdef SIMD_X86
+static const transform_resample_kernels_s _simd_sse2_resample_kernels = {
+	__sse2_resample_h_row,
+	__sse2_resample_v_row,
+	__sse2_halve_row,
+	__sse2_average_rows,
+};
+#endif
+
+#ifdef SIMD_NEON
+static const transform_resample_kernels_s _simd_neon_resample_kernels = {
+	__neon_resample_h_row,
+	__neon_resample_v_row,
+	__neon_halve_row,
+	__neon_average_rows,
+};
+#endif
+
+static const transform_resample_kernels_s _simd_scalar_resample_kernels = {
+	_transform_resample_h_row,
+	_transform_resample_v_row,
+	_transform_halve_row,
+	_transform_average,
+};
+
+/* the multiplies of the 16 bits pairs of SSE2 are enough, the resampling is bound by the loads of the taps */
+static gsize __select_resample_kernels(void)
+{
+#ifdef SIMD_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse2")) {
+		image_util_debug("SSE2 resample kernels");
+		return (gsize)&_simd_sse2_resample_kernels;
+	}
+#endif
+
+#ifdef SIMD_NEON
+	image_util_debug("NEON resample kernels");
+	return (gsize)&_simd_neon_resample_kernels;
+#endif
+
+	image_util_debug("scalar resample kernels");
+	return (gsize)&_simd_scalar_resample_kernels;
+}
+
+const transform_resample_kernels_s *_transform_get_resample_kernels(void)
+{
+	static gsize kernels = 0;
+
+	if (g_once_init_enter(&kernels))
+		g_once_init_leave(&kernels, __select_resample_kernels());
+
+	return (const transform_resample_kernels_s *)kernels;
+}
+
+static void __transpose_8(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height)
+{
+	_transform_transpose(in, in_stride, out, out_stride, width, height, 1);
+}
+
+static void __transpose_16(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height)
+{
+	_transform_transpose(in, in_stride, out, out_stride, width, height, 2);
+}
+
+/* the 3 bytes samples don't fit the lanes, they are moved by the reference in the blocks of the caller */
+static void __transpose_24(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height)
+{
+	_transform_transpose(in, in_stride, out, out_stride, width, height, 3);
+}
+
+static void __transpose_32(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height)
+{
+	_transform_transpose(in, in_stride, out, out_stride, width, height, 4);
+}
+
+#ifdef SIMD_X86
+static const transform_transpose_kernels_s _simd_sse2_transpose_kernels = {
+	{ __sse2_transpose_8, __sse2_transpose_16, __transpose_24, __sse2_transpose_32 },
+};
+#endif
+
+#ifdef SIMD_NEON
+static const transform_transpose_kernels_s _simd_neon_transpose_kernels = {
+	{ __neon_transpose_8, __neon_transpose_16, __transpose_24, __neon_transpose_32 },
+};
+#endif
+
+static const transform_transpose_kernels_s _simd_scalar_transpose_kernels = {
+	{ __transpose_8, __transpose_16, __transpose_24, __transpose_32 },
+};
+
+/* the transposes are bound by the memory, the unpacks of SSE2 are enough */
+static gsize __select_transpose_kernels(void)
+{
+#ifdef SIMD_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse2")) {
+		image_util_debug("SSE2 transpose kernels");
+		return (gsize)&_simd_sse2_transpose_kernels;
+	}
+#endif
+
+#ifdef SIMD_NEON
+	image_util_debug("NEON transpose kernels");
+	return (gsize)&_simd_neon_transpose_kernels;
+#endif
+
+	image_util_debug("scalar transpose kernels");
+	return (gsize)&_simd_scalar_transpose_kernels;
+}
+
+const transform_transpose_kernels_s *_transform_get_transpose_kernels(void)
+{
+	static gsize kernels = 0;
+
+	if (g_once_init_enter(&kernels))
+		g_once_init_leave(&kernels, __select_transpose_kernels());
+
+	return (const transform_transpose_kernels_s *)kernels;
+}
+
+static void __reverse_8(const unsigned char *in, unsigned char *out, unsigned int count)
+{
+	_transform_reverse(in, out, count, 1);
+}
+
+static void __reverse_16(const unsigned char *in, unsigned char *out, unsigned int count)
+{
+	_transform_reverse(in, out, count, 2);
+}
+
+/* the 3 bytes samples don't fit the lanes as the transposes */
+static void __reverse_24(const unsigned char *in, unsigned char *out, unsigned int count)
+{
+	_transform_reverse(in, out, count, 3);
+}
+
+static void __reverse_32(const unsigned char *in, unsigned char *out, unsigned int count)
+{
+	_transform_reverse(in, out, count, 4);
+}
+
+#ifdef SIMD_X86
+static const transform_reverse_kernels_s _simd_sse2_reverse_kernels = {
+	{ __sse2_reverse_8, __sse2_reverse_16, __reverse_24, __sse2_reverse_32 },
+};
+#endif
+
+#ifdef SIMD_NEON
+static const transform_reverse_kernels_s _simd_neon_reverse_kernels = {
+	{ __neon_reverse_8, __neon_reverse_16, __reverse_24, __neon_reverse_32 },
+};
+#endif
+
+static const transform_reverse_kernels_s _simd_scalar_reverse_kernels = {
+	{ __reverse_8, __reverse_16, __reverse_24, __reverse_32 },
+};
+
+/* the shuffles of SSE2 are enough to reverse the vectors */
+static gsize __select_reverse_kernels(void)
+{
+#ifdef SIMD_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse2")) {
+		image_util_debug("SSE2 reverse kernels");
+		return (gsize)&_simd_sse2_reverse_kernels;
+	}
+#endif
+
+#ifdef SIMD_NEON
+	image_util_debug("NEON reverse kernels");
+	return (gsize)&_simd_neon_reverse_kernels;
+#endif
+
+	image_util_debug("scalar reverse kernels");
+	return (gsize)&_simd_scalar_reverse_kernels;
+}
+
+const transform_reverse_kernels_s *_transform_get_reverse_kernels(void)
+{
+	static gsize kernels = 0;
+
+	if (g_once_init_enter(&kernels))
+		g_once_init_leave(&kernels, __select_reverse_kernels());
+
+	return (const transform_reverse_kernels_s *)kernels;
+}
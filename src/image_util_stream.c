@@ -0,0 +1,263 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+ * The stream transforms the frames on its own thread. The application pushes the source packets
+ * into the input ring and pops the results from the output ring, and neither side takes a lock
+ * while the thread is busy. The mutex is only for the thread to sleep and to be woken up.
+ */
+
+#include <image_util.h>
+#include <image_util_private.h>
+
+#define STREAM_MAX_SIZE		64
+
+static int __ring_init(stream_ring_s *ring, unsigned int size)
+{
+	unsigned int capacity = 1;
+
+	while (capacity < size)
+		capacity <<= 1;
+
+	ring->frames = (stream_frame_s *)calloc(capacity, sizeof(stream_frame_s));
+	image_util_retvm_if((ring->frames == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Memory allocation failed");
+
+	ring->mask = capacity - 1;
+	ring->head = 0;
+	ring->tail = 0;
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static unsigned int __ring_count(stream_ring_s *ring)
+{
+	return (unsigned int)g_atomic_int_get(&ring->tail) - (unsigned int)g_atomic_int_get(&ring->head);
+}
+
+/* the frame to be written by the producer, NULL if the ring is full */
+static stream_frame_s *__ring_get_tail(stream_ring_s *ring)
+{
+	if (__ring_count(ring) > ring->mask)
+		return NULL;
+
+	return &ring->frames[(unsigned int)g_atomic_int_get(&ring->tail) & ring->mask];
+}
+
+/* the frame to be read by the consumer, NULL if the ring is empty */
+static stream_frame_s *__ring_get_head(stream_ring_s *ring)
+{
+	if (__ring_count(ring) == 0)
+		return NULL;
+
+	return &ring->frames[(unsigned int)g_atomic_int_get(&ring->head) & ring->mask];
+}
+
+/* the frame is published to the consumer after it is written */
+static void __ring_push(stream_ring_s *ring)
+{
+	g_atomic_int_inc(&ring->tail);
+}
+
+/* the slot is returned to the producer after the frame is read */
+static void __ring_pop(stream_ring_s *ring)
+{
+	g_atomic_int_inc(&ring->head);
+}
+
+static bool __stream_is_ready(transformation_stream_s *stream)
+{
+	return (__ring_count(&stream->input) != 0 && __ring_count(&stream->output) <= stream->output.mask);
+}
+
+static void __stream_wake(transformation_stream_s *stream)
+{
+	/* the ring is updated before, so the thread sees it or is woken up */
+	if (!g_atomic_int_get(&stream->sleeping))
+		return;
+
+	g_mutex_lock(&stream->mutex);
+	g_cond_signal(&stream->cond);
+	g_mutex_unlock(&stream->mutex);
+}
+
+static void __stream_sleep(transformation_stream_s *stream)
+{
+	g_mutex_lock(&stream->mutex);
+	g_atomic_int_set(&stream->sleeping, 1);
+	while (!g_atomic_int_get(&stream->quit) && !__stream_is_ready(stream))
+		g_cond_wait(&stream->cond, &stream->mutex);
+	g_atomic_int_set(&stream->sleeping, 0);
+	g_mutex_unlock(&stream->mutex);
+}
+
+static gpointer __stream_thread(gpointer data)
+{
+	transformation_stream_s *stream = (transformation_stream_s *) data;
+	stream_frame_s *in = NULL;
+	stream_frame_s *out = NULL;
+
+	image_util_fenter();
+
+	while (!g_atomic_int_get(&stream->quit)) {
+		in = __ring_get_head(&stream->input);
+		out = __ring_get_tail(&stream->output);
+		if (in == NULL || out == NULL) {
+			__stream_sleep(stream);
+			continue;
+		}
+
+		out->src = in->src;
+		out->dst = NULL;
+		out->error = _image_util_transform_sync(stream->handle, NULL, in->src, &out->dst);
+		if (out->error != IMAGE_UTIL_ERROR_NONE)
+			image_util_error("_image_util_transform_sync failed (%d)", out->error);
+
+		__ring_pop(&stream->input);
+		__ring_push(&stream->output);
+	}
+
+	image_util_fleave();
+
+	return NULL;
+}
+
+int image_util_transform_stream_create(transformation_h handle, unsigned int size, transformation_stream_h *stream)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transformation_s *_handle = (transformation_s *) handle;
+	transformation_stream_s *_stream = NULL;
+	GError *error = NULL;
+
+	image_util_fenter();
+
+	image_util_retvm_if((_handle == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid Handle");
+	image_util_retvm_if((size == 0 || size > STREAM_MAX_SIZE), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid size (%u)", size);
+	image_util_retvm_if((stream == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid stream");
+
+	_stream = (transformation_stream_s *) calloc(1, sizeof(transformation_stream_s));
+	image_util_retvm_if((_stream == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Memory allocation failed");
+
+	_stream->handle = _handle;
+
+	err = __ring_init(&_stream->input, size);
+	if (err == IMAGE_UTIL_ERROR_NONE)
+		err = __ring_init(&_stream->output, size);
+	if (err != IMAGE_UTIL_ERROR_NONE) {
+		IMAGE_UTIL_SAFE_FREE(_stream->input.frames);
+		IMAGE_UTIL_SAFE_FREE(_stream);
+		return err;
+	}
+
+	g_mutex_init(&_stream->mutex);
+	g_cond_init(&_stream->cond);
+
+	_stream->thread = g_thread_try_new("transform_stream", __stream_thread, _stream, &error);
+	if (_stream->thread == NULL) {
+		image_util_error("g_thread_try_new failed (%s)", error ? error->message : "unknown");
+		if (error)
+			g_error_free(error);
+		g_cond_clear(&_stream->cond);
+		g_mutex_clear(&_stream->mutex);
+		IMAGE_UTIL_SAFE_FREE(_stream->input.frames);
+		IMAGE_UTIL_SAFE_FREE(_stream->output.frames);
+		IMAGE_UTIL_SAFE_FREE(_stream);
+		return IMAGE_UTIL_ERROR_INVALID_OPERATION;
+	}
+
+	*stream = (transformation_stream_h) _stream;
+
+	image_util_fleave();
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_stream_push(transformation_stream_h stream, media_packet_h src)
+{
+	transformation_stream_s *_stream = (transformation_stream_s *) stream;
+	stream_frame_s *frame = NULL;
+
+	image_util_retvm_if((_stream == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid stream");
+	image_util_retvm_if((src == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid source");
+
+	frame = __ring_get_tail(&_stream->input);
+	image_util_retvm_if((frame == NULL), IMAGE_UTIL_ERROR_INVALID_OPERATION, "The input is full");
+
+	frame->src = src;
+	frame->dst = NULL;
+	frame->error = IMAGE_UTIL_ERROR_NONE;
+	__ring_push(&_stream->input);
+
+	__stream_wake(_stream);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int image_util_transform_stream_pop(transformation_stream_h stream, media_packet_h *src, media_packet_h *dst)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transformation_stream_s *_stream = (transformation_stream_s *) stream;
+	stream_frame_s *frame = NULL;
+
+	image_util_retvm_if((_stream == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid stream");
+	image_util_retvm_if((src == NULL || dst == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid parameter");
+
+	frame = __ring_get_head(&_stream->output);
+	if (frame == NULL)
+		return IMAGE_UTIL_ERROR_NO_DATA;
+
+	*src = frame->src;
+	*dst = frame->dst;
+	err = frame->error;
+	__ring_pop(&_stream->output);
+
+	__stream_wake(_stream);
+
+	return err;
+}
+
+int image_util_transform_stream_destroy(transformation_stream_h stream)
+{
+	transformation_stream_s *_stream = (transformation_stream_s *) stream;
+	stream_frame_s *frame = NULL;
+
+	image_util_fenter();
+
+	image_util_retvm_if((_stream == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid stream");
+
+	g_mutex_lock(&_stream->mutex);
+	g_atomic_int_set(&_stream->quit, 1);
+	g_cond_signal(&_stream->cond);
+	g_mutex_unlock(&_stream->mutex);
+
+	g_thread_join(_stream->thread);
+
+	/* the results which are not popped, the sources belong to the application */
+	while ((frame = __ring_get_head(&_stream->output)) != NULL) {
+		if (frame->dst)
+			media_packet_destroy(frame->dst);
+		__ring_pop(&_stream->output);
+	}
+
+	g_cond_clear(&_stream->cond);
+	g_mutex_clear(&_stream->mutex);
+	IMAGE_UTIL_SAFE_FREE(_stream->input.frames);
+	IMAGE_UTIL_SAFE_FREE(_stream->output.frames);
+	IMAGE_UTIL_SAFE_FREE(_stream);
+
+	image_util_fleave();
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
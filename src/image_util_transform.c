@@ -0,0 +1,1850 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+ * The transform runs crop, resize, colorspace converting and rotation in one pass.
+ * The rows of the source are unpacked to 4 bytes pixels, resampled horizontally into a ring
+ * of rows and resampled vertically into the rows of the resized image, which are packed
+ * into the destination directly or, for 90 and 270 degree, through tiles of rows.
+ */
+
+#include <math.h>
+#include <image_util_private.h>
+#include <image_util_transform_private.h>
+
+#define FILTER_BITS		TRANSFORM_FILTER_BITS
+#define FILTER_ONE		(1 << FILTER_BITS)
+
+/* the number of the rows which are transposed at once for 90 and 270 degree */
+#define TILE_SIZE		32
+
+/* the blocks of the samples which are transposed at once, the input and the output of a block stay in the L1 cache */
+#define TRANSPOSE_BLOCK		64
+
+#define CHROMA_COUNT(width)	(((width) + 1) >> 1)
+
+/* the runs are split into the bands of the rows, which start at the even rows for the subsampled chroma */
+#define BAND_ALIGN			2
+#define BAND_MIN_PIXELS		(64 * 1024)
+#define BANDS_PER_THREAD	4
+
+/* the rows of the strips of a run by the strips, even for the subsampled chroma and a multiple of the dither pattern */
+#define STRIP_ROWS			16
+
+typedef struct {
+	bool identity;
+	unsigned int taps;
+	unsigned int *first;		/* the first input sample of each output sample */
+	unsigned int *count;		/* the number of the input samples of each output sample */
+	short *weights;				/* taps weights of each output sample */
+} transform_filter_s;
+
+typedef struct {
+	unsigned char *in_row;		/* the unpacked row of the source */
+	unsigned char *halves;		/* 2 rows of each level of the halving for the next level */
+	unsigned char *ring;		/* v_filter.taps rows which are resampled horizontally */
+	const unsigned char **ring_rows;	/* the rows of the ring for the vertical resampling */
+	unsigned char *rows;		/* 2 output rows or TILE_SIZE rows of the resized image */
+	unsigned char *segments;	/* 2 output rows of a tile */
+} transform_buffers_s;
+
+/* the source and the destination in strips of rows, the source is read from the first row of the area and each row is used once */
+typedef struct {
+	transform_read_func read;
+	transform_write_func write;
+	void *user_data;
+	int error;					/* the error of the read */
+
+	image_util_colorspace_e src_colorspace;
+	unsigned int src_width;
+	transform_image_s src;		/* the rows of the source from src_y */
+	unsigned char *src_buffer;
+	size_t src_size;
+	unsigned int src_y;
+	unsigned int src_rows;
+
+	image_util_colorspace_e dst_colorspace;
+	unsigned int dst_width;
+	transform_image_s dst;		/* the rows of the destination in the strip */
+	unsigned char *dst_buffer;
+	size_t dst_size;
+} transform_strips_s;
+
+/* everything which depends only on the formats and the geometry, made once for the frames of the same geometry */
+struct _transform_plan_s {
+	gint ref_count;
+	gint busy;					/* the buffers are used by a run */
+
+	image_util_colorspace_e src_colorspace;
+	unsigned int src_width;
+	unsigned int src_height;
+	transform_area_s area;
+	image_util_rotation_e rotation;
+	image_util_colorspace_e dst_colorspace;
+	unsigned int dst_width;
+	unsigned int dst_height;
+
+	const transform_format_s *src_format;
+	const transform_format_s *dst_format;
+	transform_pack_func pack;		/* the pack of dst_format or the dithered one */
+	bool convert_early;
+	bool dither;
+	image_util_resize_filter_e filter;
+	unsigned int max_threads;		/* 0 for the number of the processors */
+	image_util_priority_e priority;	/* of the bands on the scheduler */
+
+	/* the area is halved h_levels times horizontally and v_levels times vertically into in_width x in_height before the filters */
+	unsigned int h_levels;
+	unsigned int v_levels;
+	unsigned int in_width;
+	unsigned int in_height;
+
+	/* the size of the resized image before rotating */
+	unsigned int width;
+	unsigned int height;
+
+	transform_filter_s h_filter;
+	transform_filter_s v_filter;
+	const transform_resample_kernels_s *resample;
+
+	/* the kernels which convert the rows straight into the destination, NULL for the stages */
+	transform_yuv_to_rgb_func yuv_to_rgb;
+	transform_rgb_to_yuv_func rgb_to_yuv;
+	transform_order_e order;
+	const transform_yuv_kernels_s *yuv_kernels;		/* for the YUV sources */
+	transform_swizzle_func swizzle_row;
+	transform_swizzle_s swizzle;		/* also between RGB888 and the 4 bytes pixels for the rgb565_kernels */
+	const transform_rgb565_kernels_s *rgb565_kernels;
+	const transform_transpose_kernels_s *transpose_kernels;	/* for rotating the planes by 90 or 270 degree */
+	const transform_reverse_kernels_s *reverse_kernels;		/* for flipping the planes, also in place */
+
+	transform_buffers_s buffers;
+};
+
+typedef struct {
+	const transform_image_s *src;
+	transform_area_s area;
+	image_util_rotation_e rotation;
+	transform_image_s *dst;
+	const transform_format_s *src_format;
+	const transform_format_s *dst_format;
+	transform_pack_func pack;
+	bool convert_early;
+	bool dither;
+	transform_check_func check;
+	void *check_data;
+	transform_strips_s *strips;		/* the source rows are read in the strips instead of src if it is set */
+
+	/* the band of the rows or the tiles of the render from first to last, in the total of them */
+	unsigned int first;
+	unsigned int last;
+	unsigned int total;
+
+	unsigned int h_levels;
+	unsigned int v_levels;
+	unsigned int in_width;
+
+	/* the size of the resized image before rotating */
+	unsigned int width;
+	unsigned int height;
+
+	/* shared with the plan */
+	transform_filter_s h_filter;
+	transform_filter_s v_filter;
+	const transform_resample_kernels_s *resample;
+	transform_yuv_to_rgb_func yuv_to_rgb;
+	transform_rgb_to_yuv_func rgb_to_yuv;
+	transform_order_e order;
+	const transform_yuv_kernels_s *yuv_kernels;
+	transform_swizzle_func swizzle_row;
+	const transform_swizzle_s *swizzle;
+	const transform_rgb565_kernels_s *rgb565_kernels;
+	const transform_transpose_kernels_s *transpose_kernels;
+	const transform_reverse_kernels_s *reverse_kernels;
+
+	unsigned char *in_row;
+	unsigned char *halves;
+	unsigned char *ring;
+	unsigned int next_row;		/* the next source row to be loaded into the ring */
+	const unsigned char **ring_rows;
+	unsigned char *rows;
+	unsigned char *segments;
+} transform_context_s;
+
+static inline unsigned char __clip(int value)
+{
+	return (unsigned char)((value < 0) ? 0 : ((value > 255) ? 255 : value));
+}
+
+static inline int __round_to_int(double value)
+{
+	return (value < 0) ? (int)(value - 0.5) : (int)(value + 0.5);
+}
+
+/* the reach of @filter from the center of the output sample in the input samples, when it is widened by @filter_scale */
+static double __filter_support(image_util_resize_filter_e filter, double filter_scale)
+{
+	switch (filter) {
+	case IMAGE_UTIL_RESIZE_FILTER_BOX:
+		/* the input samples which are covered partly */
+		return 0.5 * filter_scale + 0.5;
+	case IMAGE_UTIL_RESIZE_FILTER_BICUBIC:
+		return 2.0 * filter_scale;
+	case IMAGE_UTIL_RESIZE_FILTER_LANCZOS3:
+		return 3.0 * filter_scale;
+	default:
+		return filter_scale;
+	}
+}
+
+/* the weight of the input sample at the distance @x from the center of the output sample, before the normalization */
+static double __filter_func(image_util_resize_filter_e filter, double x, double filter_scale)
+{
+	double t = x / filter_scale;
+
+	if (t < 0.0)
+		t = -t;
+
+	switch (filter) {
+	case IMAGE_UTIL_RESIZE_FILTER_BOX:
+		/* the length of the input sample which is covered by the output sample */
+		t = ((x + 0.5 < 0.5 * filter_scale) ? x + 0.5 : 0.5 * filter_scale) - ((x - 0.5 > -0.5 * filter_scale) ? x - 0.5 : -0.5 * filter_scale);
+		return (t > 0.0) ? t : 0.0;
+	case IMAGE_UTIL_RESIZE_FILTER_BICUBIC:
+		/* Catmull-Rom, a = -0.5 */
+		if (t < 1.0)
+			return (1.5 * t - 2.5) * t * t + 1.0;
+		if (t < 2.0)
+			return ((-0.5 * t + 2.5) * t - 4.0) * t + 2.0;
+		return 0.0;
+	case IMAGE_UTIL_RESIZE_FILTER_LANCZOS3:
+		if (t < 1e-8)
+			return 1.0;
+		if (t < 3.0)
+			return 3.0 * sin(M_PI * t) * sin(M_PI * t / 3.0) / (M_PI * M_PI * t * t);
+		return 0.0;
+	default:
+		return (t < 1.0) ? 1.0 - t : 0.0;
+	}
+}
+
+static void __filter_destroy(transform_filter_s *filter)
+{
+	IMAGE_UTIL_SAFE_FREE(filter->first);
+	IMAGE_UTIL_SAFE_FREE(filter->count);
+	IMAGE_UTIL_SAFE_FREE(filter->weights);
+}
+
+/* the reference of the SIMD kernels in image_util_simd.c, for the samples of @size bytes */
+void _transform_transpose(const unsigned char *in, ptrdiff_t in_stride, unsigned char *out, ptrdiff_t out_stride, unsigned int width, unsigned int height, unsigned int size)
+{
+	unsigned int x = 0, y = 0, c = 0;
+	const unsigned char *i = NULL;
+
+	/* the output rows are written one by one, the columns of the input are in the cache for the next rows */
+	for (x = 0; x < width; x++, out += out_stride) {
+		i = in + (size_t)x * size;
+		for (y = 0; y < height; y++, i += in_stride) {
+			for (c = 0; c < size; c++)
+				out[(size_t)y * size + c] = i[c];
+		}
+	}
+}
+
+/* the reference of the SIMD kernels in image_util_simd.c, the samples are swapped from both ends, so @in and @out can be the same */
+void _transform_reverse(const unsigned char *in, unsigned char *out, unsigned int count, unsigned int size)
+{
+	unsigned int i = 0, j = 0, c = 0;
+	unsigned char a = 0, b = 0;
+
+	for (i = 0; i < (count + 1) / 2; i++) {
+		j = count - 1 - i;
+		for (c = 0; c < size; c++) {
+			a = in[(size_t)i * size + c];
+			b = in[(size_t)j * size + c];
+			out[(size_t)i * size + c] = b;
+			out[(size_t)j * size + c] = a;
+		}
+	}
+}
+
+/* the size after halving @size @count times, the last odd sample is kept */
+static inline unsigned int __halve_size(unsigned int size, unsigned int count)
+{
+	return ((size - 1) >> count) + 1;
+}
+
+/*
+ * the filter which maps the @span samples from @offset of the @size samples onto @out_size samples, the input is halved
+ * @levels times before, the scale is of the samples before the halving, so the grid is kept though the last odd samples
+ * make the halved size a bit larger, the samples out of the span are used up to the ends of the @size samples,
+ * the weights of the output samples are widened by the downscaling so that every input sample is used
+ */
+static int __filter_create(transform_filter_s *filter, image_util_resize_filter_e type, unsigned int size, unsigned int offset, unsigned int span,
+	unsigned int levels, unsigned int out_size, bool reverse)
+{
+	unsigned int in_size = __halve_size(size, levels);
+	double start = (double)offset / (1U << levels);
+	double scale = (double)span / (1U << levels) / out_size;
+	double filter_scale = (scale > 1.0) ? scale : 1.0;
+	double support = __filter_support(type, filter_scale);
+	double center = 0.0, total = 0.0;
+	double *values = NULL;
+	unsigned int i = 0, k = 0, max_k = 0;
+	int first = 0, last = 0, sum = 0;
+	short *weights = NULL;
+
+	memset(filter, 0, sizeof(transform_filter_s));
+
+	if (offset == 0 && span == size && size == out_size && !reverse) {
+		filter->identity = true;
+		filter->taps = 1;
+		return IMAGE_UTIL_ERROR_NONE;
+	}
+
+	if (type == IMAGE_UTIL_RESIZE_FILTER_NEAREST) {
+		filter->taps = 1;
+	} else {
+		filter->taps = (unsigned int)support;
+		if ((double)filter->taps < support)
+			filter->taps++;
+		filter->taps = filter->taps * 2 + 1;
+	}
+
+	filter->first = (unsigned int *)calloc(out_size, sizeof(unsigned int));
+	filter->count = (unsigned int *)calloc(out_size, sizeof(unsigned int));
+	filter->weights = (short *)calloc((size_t)out_size * filter->taps, sizeof(short));
+	values = (double *)calloc(filter->taps, sizeof(double));
+	if (!filter->first || !filter->count || !filter->weights || !values) {
+		image_util_error("Memory allocation failed");
+		__filter_destroy(filter);
+		IMAGE_UTIL_SAFE_FREE(values);
+		return IMAGE_UTIL_ERROR_OUT_OF_MEMORY;
+	}
+
+	for (i = 0; i < out_size; i++) {
+		center = start + ((reverse ? out_size - 1 - i : i) + 0.5) * scale;
+
+		/* the input sample under the center */
+		if (type == IMAGE_UTIL_RESIZE_FILTER_NEAREST) {
+			filter->first[i] = ((unsigned int)center < in_size) ? (unsigned int)center : in_size - 1;
+			filter->count[i] = 1;
+			filter->weights[i] = FILTER_ONE;
+			continue;
+		}
+
+		first = (int)(center - support + 0.5);
+		if (first < 0)
+			first = 0;
+		last = (int)(center + support + 0.5);
+		if (last > (int)in_size)
+			last = (int)in_size;
+		if (last - first > (int)filter->taps)
+			last = first + (int)filter->taps;
+		if (last <= first)
+			last = first + 1;
+
+		/* the zeros at the ends are dropped, they would only be loaded and multiplied */
+		while (last - first > 1 && __filter_func(type, first - center + 0.5, filter_scale) == 0.0)
+			first++;
+		while (last - first > 1 && __filter_func(type, last - 1 - center + 0.5, filter_scale) == 0.0)
+			last--;
+
+		total = 0.0;
+		for (k = 0; k < (unsigned int)(last - first); k++) {
+			values[k] = __filter_func(type, k + first - center + 0.5, filter_scale);
+			total += values[k];
+		}
+
+		filter->first[i] = (unsigned int)first;
+		filter->count[i] = (unsigned int)(last - first);
+		weights = filter->weights + (size_t)i * filter->taps;
+
+		if (total == 0.0) {
+			weights[0] = FILTER_ONE;
+			continue;
+		}
+
+		/* the sum of the weights is FILTER_ONE exactly */
+		sum = 0;
+		max_k = 0;
+		for (k = 0; k < filter->count[i]; k++) {
+			weights[k] = (short)__round_to_int(values[k] / total * FILTER_ONE);
+			sum += weights[k];
+			if (weights[k] > weights[max_k])
+				max_k = k;
+		}
+		weights[max_k] += (short)(FILTER_ONE - sum);
+	}
+
+	IMAGE_UTIL_SAFE_FREE(values);
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* moves the filter to start at the first input sample which it uses, [@lo, @hi) are the used samples */
+static void __filter_rebase(transform_filter_s *filter, unsigned int out_size, unsigned int *lo, unsigned int *hi)
+{
+	unsigned int i = 0;
+
+	if (filter->identity) {
+		*lo = 0;
+		*hi = out_size;
+		return;
+	}
+
+	*lo = filter->first[0];
+	*hi = 0;
+	for (i = 0; i < out_size; i++) {
+		if (filter->first[i] < *lo)
+			*lo = filter->first[i];
+		if (filter->first[i] + filter->count[i] > *hi)
+			*hi = filter->first[i] + filter->count[i];
+	}
+
+	for (i = 0; i < out_size; i++)
+		filter->first[i] -= *lo;
+}
+
+/* the reference of the SIMD kernels in image_util_simd.c, resamples the 4 bytes pixels of a row */
+void _transform_resample_h_row(const unsigned char *in, unsigned char *out, unsigned int width, const unsigned int *first, const unsigned int *count, const short *weights, unsigned int taps)
+{
+	unsigned int i = 0, k = 0;
+	const unsigned char *p = NULL;
+	const short *w = NULL;
+	int acc[TRANSFORM_PIXEL_SIZE];
+
+	for (i = 0; i < width; i++, out += TRANSFORM_PIXEL_SIZE) {
+		p = in + (size_t)first[i] * TRANSFORM_PIXEL_SIZE;
+		w = weights + (size_t)i * taps;
+		acc[0] = acc[1] = acc[2] = acc[3] = FILTER_ONE >> 1;
+
+		for (k = 0; k < count[i]; k++, p += TRANSFORM_PIXEL_SIZE) {
+			acc[0] += w[k] * p[0];
+			acc[1] += w[k] * p[1];
+			acc[2] += w[k] * p[2];
+			acc[3] += w[k] * p[3];
+		}
+
+		out[0] = __clip(acc[0] >> FILTER_BITS);
+		out[1] = __clip(acc[1] >> FILTER_BITS);
+		out[2] = __clip(acc[2] >> FILTER_BITS);
+		out[3] = __clip(acc[3] >> FILTER_BITS);
+	}
+}
+
+/* the reference of the SIMD kernels in image_util_simd.c, resamples the bytes of the rows */
+void _transform_resample_v_row(const unsigned char *const *rows, const short *weights, unsigned int count, unsigned char *out, unsigned int size)
+{
+	unsigned int i = 0, k = 0;
+	int acc = 0;
+
+	for (i = 0; i < size; i++) {
+		acc = FILTER_ONE >> 1;
+		for (k = 0; k < count; k++)
+			acc += weights[k] * rows[k][i];
+		out[i] = __clip(acc >> FILTER_BITS);
+	}
+}
+
+/* the reference of the SIMD kernels in image_util_simd.c, the 2x2 box of the 4 bytes pixels, the last odd pixel is used twice */
+void _transform_halve_row(const unsigned char *row0, const unsigned char *row1, unsigned char *out, unsigned int width)
+{
+	unsigned int i = 0, c = 0, next = 0;
+
+	for (i = 0; i < width; i += 2, out += TRANSFORM_PIXEL_SIZE) {
+		next = (i + 1 < width) ? TRANSFORM_PIXEL_SIZE : 0;
+		for (c = 0; c < TRANSFORM_PIXEL_SIZE; c++, row0++, row1++)
+			out[c] = (unsigned char)((row0[0] + row0[next] + row1[0] + row1[next] + 2) >> 2);
+		row0 += TRANSFORM_PIXEL_SIZE;
+		row1 += TRANSFORM_PIXEL_SIZE;
+	}
+}
+
+/* reads the strips of the source until the row @y is in */
+static int __read_strips(transform_context_s *ctx, unsigned int y)
+{
+	transform_strips_s *strips = ctx->strips;
+	unsigned int next = 0, rows = 0;
+	int err = IMAGE_UTIL_ERROR_NONE;
+
+	while (strips->error == IMAGE_UTIL_ERROR_NONE && y >= strips->src_y + strips->src_rows) {
+		next = strips->src_y + strips->src_rows;
+		rows = ctx->area.y + ctx->area.height - next;
+		if (rows > STRIP_ROWS)
+			rows = STRIP_ROWS;
+
+		err = strips->read(next, rows, strips->src_buffer, _transform_get_buffer_size(strips->src_colorspace, strips->src_width, rows), strips->user_data);
+		if (err == IMAGE_UTIL_ERROR_NONE)
+			err = _transform_set_image(&strips->src, strips->src_colorspace, strips->src_width, rows, strips->src_buffer, strips->src_size);
+		if (err != IMAGE_UTIL_ERROR_NONE) {
+			image_util_error("reading the rows %u of %u failed (%d)", rows, next, err);
+			strips->error = err;
+			break;
+		}
+
+		strips->src_y = next;
+		strips->src_rows = rows;
+	}
+
+	return strips->error;
+}
+
+/* unpacks the @row of the area into @out, from the strip of the source if it is read in the strips */
+static void __unpack_row(transform_context_s *ctx, unsigned int row, unsigned char *out)
+{
+	unsigned int y = ctx->area.y + row;
+
+	if (!ctx->strips) {
+		ctx->src_format->unpack(ctx->src, ctx->area.x, y, ctx->area.width, out);
+		return;
+	}
+
+	/* the render stops at the error after the row */
+	if (__read_strips(ctx, y) != IMAGE_UTIL_ERROR_NONE) {
+		memset(out, 0, (size_t)ctx->area.width * TRANSFORM_PIXEL_SIZE);
+		return;
+	}
+
+	ctx->src_format->unpack(&ctx->strips->src, ctx->area.x, y - ctx->strips->src_y, ctx->area.width, out);
+}
+
+/* makes the @row of the @level of the halving of the area into @out, the level 0 is the unpacked source */
+static void __get_halved_row(transform_context_s *ctx, unsigned int level, unsigned int row, unsigned char *out)
+{
+	unsigned int h_count = 0, v_count = 0, width = 0, height = 0, l = 0;
+	unsigned char *row0 = ctx->halves, *row1 = NULL;
+	bool h_halve = false, v_halve = false;
+
+	if (level == 0) {
+		__unpack_row(ctx, row, out);
+		return;
+	}
+
+	/* the rows of the levels below are before */
+	for (l = 0; l < level; l++) {
+		h_count = (l < ctx->h_levels) ? l : ctx->h_levels;
+		v_count = (l < ctx->v_levels) ? l : ctx->v_levels;
+		width = __halve_size(ctx->area.width, h_count);
+		height = __halve_size(ctx->area.height, v_count);
+		row1 = row0 + (size_t)width * TRANSFORM_PIXEL_SIZE;
+		if (l + 1 < level)
+			row0 = row1 + (size_t)width * TRANSFORM_PIXEL_SIZE;
+	}
+
+	h_halve = (level <= ctx->h_levels);
+	v_halve = (level <= ctx->v_levels);
+
+	if (!v_halve) {
+		__get_halved_row(ctx, level - 1, row, row0);
+		ctx->resample->halve(row0, row0, out, width);
+		return;
+	}
+
+	/* the last odd row is used twice */
+	__get_halved_row(ctx, level - 1, row * 2, row0);
+	if (row * 2 + 1 < height)
+		__get_halved_row(ctx, level - 1, row * 2 + 1, row1);
+	else
+		row1 = row0;
+
+	if (h_halve)
+		ctx->resample->halve(row0, row1, out, width);
+	else
+		ctx->resample->average(row0, row1, out, width * TRANSFORM_PIXEL_SIZE);
+}
+
+static inline unsigned char *__ring_row(transform_context_s *ctx, unsigned int row)
+{
+	return ctx->ring + (size_t)(row % ctx->v_filter.taps) * ctx->width * TRANSFORM_PIXEL_SIZE;
+}
+
+/* unpacks the @row of the area and resamples it horizontally into the ring */
+static void __load_row(transform_context_s *ctx, unsigned int row)
+{
+	unsigned char *out = __ring_row(ctx, row);
+	unsigned char *in = ctx->h_filter.identity ? out : ctx->in_row;
+
+	__get_halved_row(ctx, (ctx->h_levels > ctx->v_levels) ? ctx->h_levels : ctx->v_levels, row, in);
+
+	if (ctx->convert_early)
+		_transform_convert_row(in, ctx->in_width, ctx->src_format->domain, ctx->dst_format->domain);
+
+	if (!ctx->h_filter.identity)
+		ctx->resample->h(in, out, ctx->width, ctx->h_filter.first, ctx->h_filter.count, ctx->h_filter.weights, ctx->h_filter.taps);
+}
+
+/* makes the @row of the resized image into @out, the rows have to be requested in increasing order */
+static void __get_row(transform_context_s *ctx, unsigned int row, unsigned char *out)
+{
+	const transform_filter_s *filter = &ctx->v_filter;
+	unsigned int first = ctx->v_filter.identity ? row : filter->first[row];
+	unsigned int count = ctx->v_filter.identity ? 1 : filter->count[row];
+	unsigned int size = ctx->width * TRANSFORM_PIXEL_SIZE;
+	unsigned int k = 0;
+
+	if (ctx->next_row < first)
+		ctx->next_row = first;
+	while (ctx->next_row < first + count)
+		__load_row(ctx, ctx->next_row++);
+
+	if (filter->identity) {
+		memcpy(out, __ring_row(ctx, row), size);
+	} else {
+		for (k = 0; k < count; k++)
+			ctx->ring_rows[k] = __ring_row(ctx, first + k);
+		ctx->resample->v(ctx->ring_rows, filter->weights + (size_t)row * filter->taps, count, out, size);
+	}
+
+	if (!ctx->convert_early)
+		_transform_convert_row(out, ctx->width, ctx->src_format->domain, ctx->dst_format->domain);
+}
+
+static inline int __check(transform_context_s *ctx)
+{
+	return ctx->check ? ctx->check(ctx->check_data) : IMAGE_UTIL_ERROR_NONE;
+}
+
+/* none, 180 and flip, the horizontal flip is done by the reversed h_filter */
+static int __render_rows(transform_context_s *ctx)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	unsigned int width = ctx->dst->width;
+	unsigned int height = ctx->dst->height;
+	unsigned char *row0 = ctx->rows;
+	unsigned char *row1 = ctx->rows + (size_t)width * TRANSFORM_PIXEL_SIZE;
+	unsigned int y = 0;
+	int ry = 0;
+
+	if (ctx->rotation != IMAGE_UTIL_ROTATION_FLIP_VERT && ctx->rotation != IMAGE_UTIL_ROTATION_180) {
+		for (y = ctx->first; y < ctx->last; y += 2) {
+			err = __check(ctx);
+			if (err != IMAGE_UTIL_ERROR_NONE)
+				return err;
+
+			__get_row(ctx, y, row0);
+			if (y + 1 < height)
+				__get_row(ctx, y + 1, row1);
+			ctx->pack(ctx->dst, 0, y, width, row0, (y + 1 < height) ? row1 : NULL);
+		}
+		return IMAGE_UTIL_ERROR_NONE;
+	}
+
+	/* the lines of the band are packed in pairs from the bottom, so the rows are still requested in increasing order */
+	if ((height & 1) && ctx->last == height) {
+		__get_row(ctx, 0, row0);
+		ctx->pack(ctx->dst, 0, height - 1, width, row0, NULL);
+	}
+
+	for (ry = (int)((ctx->last == height) ? height & ~1U : ctx->last) - 2; ry >= (int)ctx->first; ry -= 2) {
+		err = __check(ctx);
+		if (err != IMAGE_UTIL_ERROR_NONE)
+			return err;
+
+		__get_row(ctx, height - 2 - ry, row1);
+		__get_row(ctx, height - 1 - ry, row0);
+		ctx->pack(ctx->dst, 0, ry, width, row0, row1);
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* none and the horizontal flip in the strips, the lines are packed into the strip which is written when it is full */
+static int __render_strips(transform_context_s *ctx)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transform_strips_s *strips = ctx->strips;
+	unsigned int width = strips->dst_width;
+	unsigned int height = ctx->height;
+	unsigned char *row0 = ctx->rows;
+	unsigned char *row1 = ctx->rows + (size_t)width * TRANSFORM_PIXEL_SIZE;
+	unsigned int y = 0, strip_y = 0, rows = 0;
+
+	for (y = 0; y < height; y += 2) {
+		err = __check(ctx);
+		if (err != IMAGE_UTIL_ERROR_NONE)
+			return err;
+
+		if (y % STRIP_ROWS == 0) {
+			strip_y = y;
+			rows = (height - y < STRIP_ROWS) ? height - y : STRIP_ROWS;
+			err = _transform_set_image(&strips->dst, strips->dst_colorspace, width, rows, strips->dst_buffer, strips->dst_size);
+			if (err != IMAGE_UTIL_ERROR_NONE)
+				return err;
+		}
+
+		__get_row(ctx, y, row0);
+		if (y + 1 < height)
+			__get_row(ctx, y + 1, row1);
+		if (strips->error != IMAGE_UTIL_ERROR_NONE)
+			return strips->error;
+
+		ctx->pack(&strips->dst, 0, y - strip_y, width, row0, (y + 1 < height) ? row1 : NULL);
+
+		if (y + 2 >= strip_y + rows) {
+			err = strips->write(strip_y, rows, strips->dst_buffer, _transform_get_buffer_size(strips->dst_colorspace, width, rows), strips->user_data);
+			if (err != IMAGE_UTIL_ERROR_NONE) {
+				image_util_error("writing the rows %u of %u failed (%d)", rows, strip_y, err);
+				return err;
+			}
+		}
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* the offset of the U in the interleaved chroma */
+static inline unsigned int __get_u_idx(image_util_colorspace_e colorspace)
+{
+	return (colorspace == IMAGE_UTIL_COLORSPACE_NV21 || colorspace == IMAGE_UTIL_COLORSPACE_NV61) ? 1 : 0;
+}
+
+/* the offset of the first Y in the packed macro pixel */
+static inline unsigned int __get_y_idx(image_util_colorspace_e colorspace)
+{
+	return (colorspace == IMAGE_UTIL_COLORSPACE_UYVY) ? 1 : 0;
+}
+
+/*
+ * points the Y, U and V of the @row of the area of the YUV source, the packed line is split into @scratch
+ * and so is the interleaved chroma if @split, then *@uv_step is 1, the @scratch is for the width * 2 + 2 bytes
+ */
+static void __get_yuv_line(transform_context_s *ctx, unsigned int row, bool split, unsigned char *scratch,
+	const unsigned char **py, const unsigned char **pu, const unsigned char **pv, unsigned int *uv_step)
+{
+	const transform_image_s *src = ctx->src;
+	unsigned int width = ctx->area.width;
+	unsigned int sy = ctx->area.y + row;
+	unsigned int cy = sy >> ctx->src_format->v_shift;
+	unsigned char *y_buf = scratch;
+	unsigned char *u_buf = scratch + width;
+	unsigned char *v_buf = u_buf + CHROMA_COUNT(width);
+	const unsigned char *uv = NULL;
+	unsigned int u_idx = __get_u_idx(src->colorspace);
+
+	*uv_step = 1;
+
+	switch (ctx->src_format->num_planes) {
+	case 3:
+		*py = src->planes[0] + (size_t)sy * src->strides[0] + ctx->area.x;
+		*pu = src->planes[1] + (size_t)cy * src->strides[1] + ctx->area.x / 2;
+		*pv = src->planes[2] + (size_t)cy * src->strides[2] + ctx->area.x / 2;
+		break;
+	case 2:
+		*py = src->planes[0] + (size_t)sy * src->strides[0] + ctx->area.x;
+		uv = src->planes[1] + (size_t)cy * src->strides[1] + ctx->area.x;
+		if (split) {
+			ctx->yuv_kernels->split_uv(uv, u_idx ? v_buf : u_buf, u_idx ? u_buf : v_buf, CHROMA_COUNT(width));
+			*pu = u_buf;
+			*pv = v_buf;
+		} else {
+			*pu = uv + u_idx;
+			*pv = uv + (u_idx ^ 1);
+			*uv_step = 2;
+		}
+		break;
+	default:
+		ctx->yuv_kernels->split_packed(src->planes[0] + (size_t)sy * src->strides[0] + (size_t)ctx->area.x * 2,
+			__get_y_idx(src->colorspace), y_buf, u_buf, v_buf, width);
+		*py = y_buf;
+		*pu = u_buf;
+		*pv = v_buf;
+		break;
+	}
+}
+
+/* writes the Y of the line @y and, if @pu isn't NULL, the chroma of the line into the YUV destination */
+static void __put_yuv_line(transform_context_s *ctx, unsigned int y, const unsigned char *py, const unsigned char *pu, const unsigned char *pv)
+{
+	transform_image_s *dst = ctx->dst;
+	unsigned int width = dst->width;
+	unsigned int cy = y >> ctx->dst_format->v_shift;
+	unsigned int u_idx = __get_u_idx(dst->colorspace);
+	unsigned char *uv = NULL;
+
+	if (ctx->dst_format->num_planes == 1) {
+		ctx->yuv_kernels->merge_packed(py, pu, pv, __get_y_idx(dst->colorspace), dst->planes[0] + (size_t)y * dst->strides[0], width);
+		return;
+	}
+
+	memcpy(dst->planes[0] + (size_t)y * dst->strides[0], py, width);
+	if (!pu)
+		return;
+
+	if (ctx->dst_format->num_planes == 3) {
+		memcpy(dst->planes[1] + (size_t)cy * dst->strides[1], pu, CHROMA_COUNT(width));
+		memcpy(dst->planes[2] + (size_t)cy * dst->strides[2], pv, CHROMA_COUNT(width));
+	} else {
+		uv = dst->planes[1] + (size_t)cy * dst->strides[1];
+		ctx->yuv_kernels->merge_uv(u_idx ? pv : pu, u_idx ? pu : pv, uv, CHROMA_COUNT(width));
+	}
+}
+
+/* converts the rows of the area into the destination of the same size by the yuv_to_rgb kernel of the plan */
+static int __render_yuv_to_rgb(transform_context_s *ctx)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transform_image_s *dst = ctx->dst;
+	bool packed = (dst->colorspace == IMAGE_UTIL_COLORSPACE_RGB888);
+	unsigned char *scratch = ctx->rows + (size_t)dst->width * TRANSFORM_PIXEL_SIZE;
+	const unsigned char *py = NULL, *pu = NULL, *pv = NULL;
+	unsigned int y = 0, uv_step = 0;
+
+	for (y = ctx->first; y < ctx->last; y++) {
+		if ((y & 1) == 0) {
+			err = __check(ctx);
+			if (err != IMAGE_UTIL_ERROR_NONE)
+				return err;
+		}
+
+		__get_yuv_line(ctx, y, false, scratch, &py, &pu, &pv, &uv_step);
+
+		/* RGB888 is packed from the 4 bytes pixels */
+		if (packed) {
+			ctx->yuv_to_rgb(py, pu, pv, uv_step, ctx->rows, dst->width, TRANSFORM_ORDER_RGBA);
+			ctx->pack(dst, 0, y, dst->width, ctx->rows, NULL);
+		} else {
+			ctx->yuv_to_rgb(py, pu, pv, uv_step, dst->planes[0] + (size_t)y * dst->strides[0], dst->width, ctx->order);
+		}
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/*
+ * moves the planes of the rows of the area into the YUV destination of the same size by the yuv_kernels of the plan,
+ * the chroma of 4:2:0 is the average of the chroma of the 2 lines as __average_uv() makes it from the duplicated chroma
+ */
+static int __render_yuv_layout(transform_context_s *ctx)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	unsigned int width = ctx->dst->width;
+	unsigned int height = ctx->dst->height;
+	size_t scratch_size = (size_t)width + CHROMA_COUNT(width) * 2;
+	unsigned char *scratch0 = ctx->rows;
+	unsigned char *scratch1 = scratch0 + scratch_size;
+	unsigned char *avg_u = scratch1 + scratch_size;
+	unsigned char *avg_v = avg_u + CHROMA_COUNT(width);
+	bool subsampled = (ctx->dst_format->v_shift != 0);
+	const unsigned char *py0 = NULL, *pu0 = NULL, *pv0 = NULL;
+	const unsigned char *py1 = NULL, *pu1 = NULL, *pv1 = NULL;
+	unsigned int y = 0, uv_step = 0;
+
+	for (y = ctx->first; y < ctx->last; y += 2) {
+		err = __check(ctx);
+		if (err != IMAGE_UTIL_ERROR_NONE)
+			return err;
+
+		__get_yuv_line(ctx, y, true, scratch0, &py0, &pu0, &pv0, &uv_step);
+		if (y + 1 < height)
+			__get_yuv_line(ctx, y + 1, true, scratch1, &py1, &pu1, &pv1, &uv_step);
+
+		if (subsampled && y + 1 < height) {
+			ctx->yuv_kernels->average(pu0, pu1, avg_u, CHROMA_COUNT(width));
+			ctx->yuv_kernels->average(pv0, pv1, avg_v, CHROMA_COUNT(width));
+			pu0 = avg_u;
+			pv0 = avg_v;
+		}
+
+		__put_yuv_line(ctx, y, py0, pu0, pv0);
+		if (y + 1 < height)
+			__put_yuv_line(ctx, y + 1, py1, subsampled ? NULL : pu1, pv1);
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* converts the pairs of the rows of the area into the destination of the same size by the rgb_to_yuv kernel of the plan */
+static int __render_rgb_to_yuv(transform_context_s *ctx)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	const transform_image_s *src = ctx->src;
+	transform_image_s *dst = ctx->dst;
+	bool planar = (ctx->dst_format->num_planes == 3);
+	unsigned int u_idx = __get_u_idx(dst->colorspace);
+	bool packed = (src->colorspace == IMAGE_UTIL_COLORSPACE_RGB888);
+	size_t row_size = (size_t)dst->width * TRANSFORM_PIXEL_SIZE;
+	const unsigned char *row0 = NULL, *row1 = NULL;
+	unsigned char *py0 = NULL, *py1 = NULL, *pu = NULL, *pv = NULL;
+	unsigned int y = 0, sy = 0, cy = 0;
+	bool last = false;
+
+	for (y = ctx->first; y < ctx->last; y += 2) {
+		err = __check(ctx);
+		if (err != IMAGE_UTIL_ERROR_NONE)
+			return err;
+
+		last = (y + 1 >= dst->height);
+		sy = ctx->area.y + y;
+		cy = y >> 1;
+
+		/* RGB888 is unpacked into the 4 bytes pixels */
+		if (packed) {
+			ctx->src_format->unpack(src, ctx->area.x, sy, dst->width, ctx->rows);
+			if (!last)
+				ctx->src_format->unpack(src, ctx->area.x, sy + 1, dst->width, ctx->rows + row_size);
+			row0 = ctx->rows;
+		} else {
+			row0 = src->planes[0] + (size_t)sy * src->strides[0] + (size_t)ctx->area.x * TRANSFORM_PIXEL_SIZE;
+		}
+		row1 = last ? NULL : (packed ? row0 + row_size : row0 + src->strides[0]);
+
+		py0 = dst->planes[0] + (size_t)y * dst->strides[0];
+		py1 = last ? NULL : py0 + dst->strides[0];
+		if (planar) {
+			pu = dst->planes[1] + (size_t)cy * dst->strides[1];
+			pv = dst->planes[2] + (size_t)cy * dst->strides[2];
+		} else {
+			pu = dst->planes[1] + (size_t)cy * dst->strides[1] + u_idx;
+			pv = dst->planes[1] + (size_t)cy * dst->strides[1] + (u_idx ^ 1);
+		}
+
+		ctx->rgb_to_yuv(row0, row1, py0, py1, pu, pv, planar ? 1 : 2, dst->width, ctx->order);
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* reorders the bytes of the rows of the area into the RGB destination of the same size, the rows can be the same */
+static int __render_swizzle(transform_context_s *ctx)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	const transform_image_s *src = ctx->src;
+	transform_image_s *dst = ctx->dst;
+	const transform_swizzle_s *swizzle = ctx->swizzle;
+	bool same = (src->colorspace == dst->colorspace);
+	const unsigned char *in = NULL;
+	unsigned char *out = NULL;
+	unsigned int y = 0;
+
+	for (y = ctx->first; y < ctx->last; y++) {
+		if ((y & 1) == 0) {
+			err = __check(ctx);
+			if (err != IMAGE_UTIL_ERROR_NONE)
+				return err;
+		}
+
+		in = src->planes[0] + (size_t)(ctx->area.y + y) * src->strides[0] + (size_t)ctx->area.x * swizzle->in_bpp;
+		out = dst->planes[0] + (size_t)y * dst->strides[0];
+
+		if (same)
+			memmove(out, in, (size_t)dst->width * swizzle->out_bpp);
+		else
+			ctx->swizzle_row(in, out, dst->width, swizzle);
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/*
+ * converts the rows of the area between RGB565 and the other RGB of the same size by the rgb565_kernels of the plan,
+ * RGB888 is reordered to or from the 4 bytes pixels in ctx->rows by the swizzle of the plan
+ */
+static int __render_rgb565(transform_context_s *ctx)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	const transform_image_s *src = ctx->src;
+	transform_image_s *dst = ctx->dst;
+	bool unpack = (src->colorspace == IMAGE_UTIL_COLORSPACE_RGB565);
+	bool packed = ((unpack ? dst : src)->colorspace == IMAGE_UTIL_COLORSPACE_RGB888);
+	unsigned int in_bpp = unpack ? 2 : (packed ? 3 : TRANSFORM_PIXEL_SIZE);
+	const unsigned char *in = NULL;
+	unsigned char *out = NULL;
+	unsigned int y = 0;
+
+	for (y = ctx->first; y < ctx->last; y++) {
+		if ((y & 1) == 0) {
+			err = __check(ctx);
+			if (err != IMAGE_UTIL_ERROR_NONE)
+				return err;
+		}
+
+		in = src->planes[0] + (size_t)(ctx->area.y + y) * src->strides[0] + (size_t)ctx->area.x * in_bpp;
+		out = dst->planes[0] + (size_t)y * dst->strides[0];
+
+		if (unpack) {
+			if (packed) {
+				ctx->rgb565_kernels->unpack(in, ctx->rows, dst->width, TRANSFORM_ORDER_RGBA);
+				ctx->swizzle_row(ctx->rows, out, dst->width, ctx->swizzle);
+			} else {
+				ctx->rgb565_kernels->unpack(in, out, dst->width, ctx->order);
+			}
+			continue;
+		}
+
+		if (packed) {
+			ctx->swizzle_row(in, ctx->rows, dst->width, ctx->swizzle);
+			in = ctx->rows;
+		}
+		ctx->rgb565_kernels->pack(in, out, dst->width, ctx->order, ctx->dither ? _transform_get_dither_row(y) : NULL);
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* the rows of the band in a plane of @height rows which are subsampled by @shift, the bands start at the even rows */
+static void __get_band_rows(const transform_context_s *ctx, unsigned int height, unsigned int shift, unsigned int *first, unsigned int *last)
+{
+	*first = ctx->first >> shift;
+	*last = (ctx->last >= ctx->total) ? height : ctx->last >> shift;
+}
+
+/* the bytes of the samples of the @plane, the chroma of the 2 planes YUV is the pair of U and V */
+static unsigned int __get_sample_size(const transform_image_s *image, const transform_format_s *format, unsigned int plane)
+{
+	if (format->domain == TRANSFORM_DOMAIN_YUV)
+		return (plane != 0 && format->num_planes == 2) ? 2 : 1;
+
+	switch (image->colorspace) {
+	case IMAGE_UTIL_COLORSPACE_RGB565:
+		return 2;
+	case IMAGE_UTIL_COLORSPACE_RGB888:
+		return 3;
+	default:
+		return TRANSFORM_PIXEL_SIZE;
+	}
+}
+
+/* the X of the @count pixels of BGRX, which the copies of the samples bring from the source, is 0xff as the other paths write it */
+static void __set_x(unsigned char *out, unsigned int count)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < count; i++)
+		out[i * 4 + 3] = 0xff;
+}
+
+/*
+ * rotates each plane of the area into the destination of the same colorspace by the transpose_kernels of the plan,
+ * the source is read upward for 90 degree and the destination is written upward for 270 degree
+ */
+static int __render_transpose(transform_context_s *ctx)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	const transform_image_s *src = ctx->src;
+	transform_image_s *dst = ctx->dst;
+	bool cw = (ctx->rotation == IMAGE_UTIL_ROTATION_90);
+	unsigned int plane = 0, h_shift = 0, v_shift = 0, size = 0, width = 0, height = 0;
+	unsigned int bx = 0, by = 0, bw = 0, bh = 0, first = 0, last = 0, k = 0;
+	bool set_x = (dst->colorspace == IMAGE_UTIL_COLORSPACE_BGRX8888);
+	transform_transpose_func transpose = NULL;
+	const unsigned char *in = NULL;
+	unsigned char *out = NULL;
+	ptrdiff_t in_stride = 0, out_stride = 0;
+
+	for (plane = 0; plane < ctx->src_format->num_planes; plane++) {
+		h_shift = plane ? ctx->src_format->h_shift : 0;
+		v_shift = plane ? ctx->src_format->v_shift : 0;
+		size = __get_sample_size(src, ctx->src_format, plane);
+		width = __halve_size(ctx->area.width, h_shift);
+		height = __halve_size(ctx->area.height, v_shift);
+		transpose = ctx->transpose_kernels->transpose[size - 1];
+
+		in = src->planes[plane] + (size_t)(ctx->area.y >> v_shift) * src->strides[plane] + (size_t)(ctx->area.x >> h_shift) * size;
+		in_stride = (ptrdiff_t)src->strides[plane];
+		out = dst->planes[plane];
+		out_stride = (ptrdiff_t)dst->strides[plane];
+		if (cw) {
+			in += (ptrdiff_t)(height - 1) * in_stride;
+			in_stride = -in_stride;
+		} else {
+			out += (ptrdiff_t)(width - 1) * out_stride;
+			out_stride = -out_stride;
+		}
+
+		__get_band_rows(ctx, height, v_shift, &first, &last);
+		for (by = first; by < last; by += TRANSPOSE_BLOCK) {
+			err = __check(ctx);
+			if (err != IMAGE_UTIL_ERROR_NONE)
+				return err;
+
+			bh = (last - by < TRANSPOSE_BLOCK) ? last - by : TRANSPOSE_BLOCK;
+			for (bx = 0; bx < width; bx += TRANSPOSE_BLOCK) {
+				bw = (width - bx < TRANSPOSE_BLOCK) ? width - bx : TRANSPOSE_BLOCK;
+				transpose(in + (ptrdiff_t)by * in_stride + (size_t)bx * size, in_stride,
+					out + (ptrdiff_t)bx * out_stride + (size_t)by * size, out_stride, bw, bh);
+				for (k = 0; set_x && k < bw; k++)
+					__set_x(out + (ptrdiff_t)(bx + k) * out_stride + (size_t)by * size, bh);
+			}
+		}
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* copies the @count samples of @in into @out, reversed if @reverse, the 2 Y of the reversed YUYV and UYVY are swapped back */
+static void __flip_row(transform_context_s *ctx, const unsigned char *in, unsigned char *out, unsigned int count, unsigned int size, bool reverse)
+{
+	unsigned int y_idx = 0, i = 0;
+	unsigned char y = 0;
+
+	if (!reverse) {
+		if (in != out)
+			memcpy(out, in, (size_t)count * size);
+		if (ctx->dst->colorspace == IMAGE_UTIL_COLORSPACE_BGRX8888)
+			__set_x(out, count);
+		return;
+	}
+
+	ctx->reverse_kernels->reverse[size - 1](in, out, count);
+	if (ctx->dst->colorspace == IMAGE_UTIL_COLORSPACE_BGRX8888)
+		__set_x(out, count);
+
+	if (ctx->src_format->domain != TRANSFORM_DOMAIN_YUV || ctx->src_format->num_planes != 1)
+		return;
+
+	y_idx = __get_y_idx(ctx->src->colorspace);
+	for (i = 0; i < count; i++, out += 4) {
+		y = out[y_idx];
+		out[y_idx] = out[y_idx + 2];
+		out[y_idx + 2] = y;
+	}
+}
+
+/*
+ * flips each plane of the area into the destination of the same colorspace by the reverse_kernels of the plan,
+ * the rows are swapped through ctx->rows if the source is the destination, 180 degree is both of the flips
+ */
+static int __render_flip(transform_context_s *ctx)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	const transform_image_s *src = ctx->src;
+	transform_image_s *dst = ctx->dst;
+	bool h_flip = (ctx->rotation == IMAGE_UTIL_ROTATION_FLIP_HORZ || ctx->rotation == IMAGE_UTIL_ROTATION_180);
+	bool v_flip = (ctx->rotation == IMAGE_UTIL_ROTATION_FLIP_VERT || ctx->rotation == IMAGE_UTIL_ROTATION_180);
+	bool packed = (ctx->src_format->domain == TRANSFORM_DOMAIN_YUV && ctx->src_format->num_planes == 1);
+	unsigned int plane = 0, h_shift = 0, v_shift = 0, size = 0, count = 0, height = 0, y = 0, sy = 0, first = 0, last = 0;
+	const unsigned char *in = NULL;
+	unsigned char *row = NULL, *out = NULL;
+	bool in_place = false;
+
+	for (plane = 0; plane < ctx->src_format->num_planes; plane++) {
+		h_shift = plane ? ctx->src_format->h_shift : 0;
+		v_shift = plane ? ctx->src_format->v_shift : 0;
+		/* the 2 pixels of YUYV and UYVY are a sample */
+		if (packed) {
+			h_shift = 1;
+			size = 4;
+		} else {
+			size = __get_sample_size(src, ctx->src_format, plane);
+		}
+		count = __halve_size(ctx->area.width, h_shift);
+		height = __halve_size(ctx->area.height, v_shift);
+		in = src->planes[plane] + (size_t)(ctx->area.y >> v_shift) * src->strides[plane] + (size_t)(ctx->area.x >> h_shift) * size;
+		in_place = (src->planes[plane] == dst->planes[plane]);
+
+		/* the band is of the pairs of the rows to be swapped in place */
+		__get_band_rows(ctx, (in_place && v_flip) ? (height + 1) / 2 : height, v_shift, &first, &last);
+		for (y = first; y < last; y++) {
+			if ((y & 1) == 0) {
+				err = __check(ctx);
+				if (err != IMAGE_UTIL_ERROR_NONE)
+					return err;
+			}
+
+			sy = v_flip ? height - 1 - y : y;
+			out = dst->planes[plane] + (size_t)y * dst->strides[plane];
+
+			if (!in_place) {
+				__flip_row(ctx, in + (size_t)sy * src->strides[plane], out, count, size, h_flip);
+				continue;
+			}
+
+			/* the pairs of the rows are swapped until the middle */
+			if (sy < y)
+				break;
+			if (sy == y) {
+				__flip_row(ctx, out, out, count, size, h_flip);
+				continue;
+			}
+
+			row = dst->planes[plane] + (size_t)sy * dst->strides[plane];
+			__flip_row(ctx, row, ctx->rows, count, size, h_flip);
+			__flip_row(ctx, out, row, count, size, h_flip);
+			memcpy(out, ctx->rows, (size_t)count * size);
+		}
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+/* gathers the @column of the @count rows of the tile into @out, in reverse order if @reverse */
+static void __get_column(transform_context_s *ctx, unsigned int column, unsigned int count, bool reverse, unsigned char *out)
+{
+	size_t size = (size_t)ctx->width * TRANSFORM_PIXEL_SIZE;
+	const unsigned char *in = ctx->rows + (size_t)column * TRANSFORM_PIXEL_SIZE;
+	unsigned int i = 0;
+
+	for (i = 0; i < count; i++, in += size)
+		memcpy(out + (size_t)(reverse ? count - 1 - i : i) * TRANSFORM_PIXEL_SIZE, in, TRANSFORM_PIXEL_SIZE);
+}
+
+/*
+ * 90 degree:  dst(x, y) = resized(y, height - 1 - x)
+ * 270 degree: dst(x, y) = resized(width - 1 - y, x)
+ * The tiles are the TILE_SIZE columns of the destination, which are the rows of the resized image.
+ */
+static int __render_tiles(transform_context_s *ctx)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	bool cw = (ctx->rotation == IMAGE_UTIL_ROTATION_90);
+	unsigned int width = ctx->dst->width;
+	unsigned int height = ctx->dst->height;
+	unsigned char *seg0 = ctx->segments;
+	unsigned char *seg1 = ctx->segments + TILE_SIZE * TRANSFORM_PIXEL_SIZE;
+	unsigned int tile = 0, num_tiles = (width + TILE_SIZE - 1) / TILE_SIZE;
+	unsigned int x = 0, tw = 0, first = 0, k = 0, y = 0;
+
+	for (tile = ctx->first; tile < ctx->last; tile++) {
+		err = __check(ctx);
+		if (err != IMAGE_UTIL_ERROR_NONE)
+			return err;
+
+		/* the tiles are visited in increasing order of the rows of the resized image */
+		x = (cw ? num_tiles - 1 - tile : tile) * TILE_SIZE;
+		tw = (width - x < TILE_SIZE) ? width - x : TILE_SIZE;
+		first = cw ? width - x - tw : x;
+
+		for (k = 0; k < tw; k++)
+			__get_row(ctx, first + k, ctx->rows + (size_t)k * ctx->width * TRANSFORM_PIXEL_SIZE);
+
+		for (y = 0; y < height; y += 2) {
+			__get_column(ctx, cw ? y : height - 1 - y, tw, cw, seg0);
+			if (y + 1 < height)
+				__get_column(ctx, cw ? y + 1 : height - 2 - y, tw, cw, seg1);
+			ctx->pack(ctx->dst, x, y, tw, seg0, (y + 1 < height) ? seg1 : NULL);
+		}
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static void __buffers_destroy(transform_buffers_s *buffers)
+{
+	IMAGE_UTIL_SAFE_FREE(buffers->in_row);
+	IMAGE_UTIL_SAFE_FREE(buffers->halves);
+	IMAGE_UTIL_SAFE_FREE(buffers->ring);
+	IMAGE_UTIL_SAFE_FREE(buffers->ring_rows);
+	IMAGE_UTIL_SAFE_FREE(buffers->rows);
+	IMAGE_UTIL_SAFE_FREE(buffers->segments);
+}
+
+static int __buffers_create(const transform_plan_s *plan, transform_buffers_s *buffers)
+{
+	size_t row_size = (size_t)plan->width * TRANSFORM_PIXEL_SIZE;
+	size_t halves_size = 0;
+	unsigned int l = 0, levels = (plan->h_levels > plan->v_levels) ? plan->h_levels : plan->v_levels;
+
+	memset(buffers, 0, sizeof(transform_buffers_s));
+
+	/* 2 rows of each level but the last one */
+	for (l = 0; l < levels; l++)
+		halves_size += (size_t)__halve_size(plan->area.width, (l < plan->h_levels) ? l : plan->h_levels) * 2;
+
+	buffers->in_row = (unsigned char *)calloc(plan->in_width, TRANSFORM_PIXEL_SIZE);
+	buffers->halves = (unsigned char *)calloc(halves_size + 1, TRANSFORM_PIXEL_SIZE);
+	buffers->ring = (unsigned char *)calloc(plan->v_filter.taps, row_size);
+	buffers->ring_rows = (const unsigned char **)calloc(plan->v_filter.taps, sizeof(unsigned char *));
+	if (plan->rotation == IMAGE_UTIL_ROTATION_90 || plan->rotation == IMAGE_UTIL_ROTATION_270) {
+		buffers->rows = (unsigned char *)calloc(TILE_SIZE, row_size);
+		buffers->segments = (unsigned char *)calloc(2 * TILE_SIZE, TRANSFORM_PIXEL_SIZE);
+	} else {
+		buffers->rows = (unsigned char *)calloc(2, row_size);
+		buffers->segments = (unsigned char *)calloc(1, TRANSFORM_PIXEL_SIZE);
+	}
+
+	if (!buffers->in_row || !buffers->halves || !buffers->ring || !buffers->ring_rows || !buffers->rows || !buffers->segments) {
+		image_util_error("Memory allocation failed");
+		__buffers_destroy(buffers);
+		return IMAGE_UTIL_ERROR_OUT_OF_MEMORY;
+	}
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+static bool __is_yuv420(image_util_colorspace_e colorspace)
+{
+	switch (colorspace) {
+	case IMAGE_UTIL_COLORSPACE_YV12:
+	case IMAGE_UTIL_COLORSPACE_I420:
+	case IMAGE_UTIL_COLORSPACE_NV12:
+	case IMAGE_UTIL_COLORSPACE_NV21:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* the order of the 4 bytes pixels of the RGB @colorspace for the kernels, RGB888 is unpacked to RGBA */
+static bool __get_rgb_order(image_util_colorspace_e colorspace, transform_order_e *order)
+{
+	switch (colorspace) {
+	case IMAGE_UTIL_COLORSPACE_RGB888:
+	case IMAGE_UTIL_COLORSPACE_RGBA8888:
+		*order = TRANSFORM_ORDER_RGBA;
+		return true;
+	case IMAGE_UTIL_COLORSPACE_BGRA8888:
+	case IMAGE_UTIL_COLORSPACE_BGRX8888:
+		*order = TRANSFORM_ORDER_BGRA;
+		return true;
+	case IMAGE_UTIL_COLORSPACE_ARGB8888:
+		*order = TRANSFORM_ORDER_ARGB;
+		return true;
+	default:
+		return false;
+	}
+}
+
+/*
+ * the kernels for converting the YUV to RGB or to the other layouts of YUV, RGB to 4:2:0 YUV and between the orders of RGB
+ * or RGB565 without resizing and rotating, which are the most of the previews, of the camera frames, of the frames for
+ * the encoders and of the 16 bits framebuffers
+ */
+static void __set_direct_kernel(transform_plan_s *plan)
+{
+	const transform_format_s *format = plan->src_format;
+	bool h_flip = (plan->rotation == IMAGE_UTIL_ROTATION_FLIP_HORZ || plan->rotation == IMAGE_UTIL_ROTATION_180);
+	bool v_flip = (plan->rotation == IMAGE_UTIL_ROTATION_FLIP_VERT || plan->rotation == IMAGE_UTIL_ROTATION_180);
+
+	if (plan->area.width != plan->width || plan->area.height != plan->height)
+		return;
+
+	/* the planes are transposed as they are, the chroma only if its subsampling is the same in both ways */
+	if (plan->rotation == IMAGE_UTIL_ROTATION_90 || plan->rotation == IMAGE_UTIL_ROTATION_270) {
+		if (plan->src_colorspace != plan->dst_colorspace)
+			return;
+		if (format->domain == TRANSFORM_DOMAIN_YUV && (format->num_planes == 1 ||
+			format->h_shift != format->v_shift || (plan->area.x & 1) || (plan->area.y & 1)))
+			return;
+
+		plan->transpose_kernels = _transform_get_transpose_kernels();
+		return;
+	}
+
+	/* the planes are reversed as they are, the subsampled chroma only if it covers the same pixels after flipping */
+	if (h_flip || v_flip) {
+		if (plan->src_colorspace != plan->dst_colorspace)
+			return;
+		if (format->domain == TRANSFORM_DOMAIN_YUV && ((format->h_shift && ((plan->area.x & 1) || (h_flip && (plan->area.width & 1)))) ||
+			(format->v_shift && ((plan->area.y & 1) || (v_flip && (plan->area.height & 1))))))
+			return;
+
+		plan->reverse_kernels = _transform_get_reverse_kernels();
+		return;
+	}
+
+	if (plan->src_format->domain == TRANSFORM_DOMAIN_YUV) {
+		/* the chroma of the 2 pixels would be split from odd x */
+		if (plan->area.x & 1)
+			return;
+
+		plan->yuv_kernels = _transform_get_yuv_kernels();
+		if (__get_rgb_order(plan->dst_colorspace, &plan->order))
+			plan->yuv_to_rgb = _transform_get_yuv_to_rgb_func();
+		return;
+	}
+
+	if (__is_yuv420(plan->dst_colorspace) && __get_rgb_order(plan->src_colorspace, &plan->order)) {
+		plan->rgb_to_yuv = _transform_get_rgb_to_yuv_func();
+	} else if ((plan->src_colorspace == IMAGE_UTIL_COLORSPACE_RGB565 && __get_rgb_order(plan->dst_colorspace, &plan->order)) ||
+		(plan->dst_colorspace == IMAGE_UTIL_COLORSPACE_RGB565 && __get_rgb_order(plan->src_colorspace, &plan->order))) {
+		plan->rgb565_kernels = _transform_get_rgb565_kernels();
+		if (plan->src_colorspace == IMAGE_UTIL_COLORSPACE_RGB888 || plan->dst_colorspace == IMAGE_UTIL_COLORSPACE_RGB888) {
+			_transform_get_swizzle((plan->src_colorspace == IMAGE_UTIL_COLORSPACE_RGB888) ? IMAGE_UTIL_COLORSPACE_RGB888 : IMAGE_UTIL_COLORSPACE_RGBA8888,
+				(plan->dst_colorspace == IMAGE_UTIL_COLORSPACE_RGB888) ? IMAGE_UTIL_COLORSPACE_RGB888 : IMAGE_UTIL_COLORSPACE_RGBA8888, &plan->swizzle);
+			plan->swizzle_row = _transform_get_swizzle_func();
+		}
+	} else if (_transform_get_swizzle(plan->src_colorspace, plan->dst_colorspace, &plan->swizzle))
+		plan->swizzle_row = _transform_get_swizzle_func();
+}
+
+static void __plan_destroy(transform_plan_s *plan)
+{
+	__filter_destroy(&plan->h_filter);
+	__filter_destroy(&plan->v_filter);
+	__buffers_destroy(&plan->buffers);
+	IMAGE_UTIL_SAFE_FREE(plan);
+}
+
+void _transform_get_output_size(unsigned int width, unsigned int height, image_util_rotation_e rotation, unsigned int *out_width, unsigned int *out_height)
+{
+	if (rotation == IMAGE_UTIL_ROTATION_90 || rotation == IMAGE_UTIL_ROTATION_270) {
+		*out_width = height;
+		*out_height = width;
+	} else {
+		*out_width = width;
+		*out_height = height;
+	}
+}
+
+/*
+ * the plan which resamples the @area onto the destination, with @roi, the samples around the @area are also used
+ * for the filters like the whole image is resized, and the area of the plan is made of the samples which are used
+ */
+static int __plan_create(image_util_colorspace_e src_colorspace, unsigned int src_width, unsigned int src_height, const transform_area_s *area, bool roi,
+	image_util_rotation_e rotation, image_util_colorspace_e dst_colorspace, unsigned int dst_width, unsigned int dst_height, const transform_options_s *options, transform_plan_s **plan)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transform_plan_s *_plan = NULL;
+	bool rotated = (rotation == IMAGE_UTIL_ROTATION_90 || rotation == IMAGE_UTIL_ROTATION_270);
+	bool h_reverse = (rotation == IMAGE_UTIL_ROTATION_FLIP_HORZ || rotation == IMAGE_UTIL_ROTATION_180);
+	unsigned int lo = 0, hi = 0;
+	transform_area_s _area = { 0, 0, src_width, src_height };
+
+	image_util_retvm_if((plan == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid plan");
+	image_util_retvm_if((dst_width == 0 || dst_height == 0), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid dst resolution");
+	image_util_retvm_if((_transform_get_format(src_colorspace) == NULL || _transform_get_format(dst_colorspace) == NULL), IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT, "Not supported format");
+
+	if (area)
+		_area = *area;
+	image_util_retvm_if((_area.x >= src_width || _area.width == 0 || _area.width > src_width - _area.x ||
+		_area.y >= src_height || _area.height == 0 || _area.height > src_height - _area.y),
+		IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid area (%u, %u, %u x %u)", _area.x, _area.y, _area.width, _area.height);
+
+	_plan = (transform_plan_s *)calloc(1, sizeof(transform_plan_s));
+	image_util_retvm_if((_plan == NULL), IMAGE_UTIL_ERROR_OUT_OF_MEMORY, "Memory allocation failed");
+
+	_plan->ref_count = 1;
+	_plan->src_colorspace = src_colorspace;
+	_plan->src_width = src_width;
+	_plan->src_height = src_height;
+	_plan->area = _area;
+	_plan->rotation = rotation;
+	_plan->dst_colorspace = dst_colorspace;
+	_plan->dst_width = dst_width;
+	_plan->dst_height = dst_height;
+	_plan->src_format = _transform_get_format(src_colorspace);
+	_plan->dst_format = _transform_get_format(dst_colorspace);
+	_plan->dither = (options && options->dither && dst_colorspace == IMAGE_UTIL_COLORSPACE_RGB565);
+	_plan->pack = _plan->dither ? _transform_pack_rgb565_dither : _plan->dst_format->pack;
+	_plan->filter = options ? options->filter : IMAGE_UTIL_RESIZE_FILTER_BILINEAR;
+	_plan->max_threads = options ? options->max_threads : 0;
+	_plan->priority = options ? options->priority : IMAGE_UTIL_PRIORITY_NORMAL;
+	_plan->width = rotated ? dst_height : dst_width;
+	_plan->height = rotated ? dst_width : dst_height;
+
+	/* the large downscales are halved by the 2x2 box until they are within 2x, the filters are left for the rest */
+	_plan->in_width = _area.width;
+	_plan->in_height = _area.height;
+	if (_plan->filter != IMAGE_UTIL_RESIZE_FILTER_NEAREST) {
+		while (_plan->in_width > _plan->width * 2) {
+			_plan->in_width = __halve_size(_plan->in_width, 1);
+			_plan->h_levels++;
+		}
+		while (_plan->in_height > _plan->height * 2) {
+			_plan->in_height = __halve_size(_plan->in_height, 1);
+			_plan->v_levels++;
+		}
+	}
+
+	if (roi) {
+		err = __filter_create(&_plan->h_filter, _plan->filter, src_width, _area.x, _area.width, _plan->h_levels, _plan->width, h_reverse);
+		if (err == IMAGE_UTIL_ERROR_NONE)
+			err = __filter_create(&_plan->v_filter, _plan->filter, src_height, _area.y, _area.height, _plan->v_levels, _plan->height, false);
+	} else {
+		err = __filter_create(&_plan->h_filter, _plan->filter, _area.width, 0, _area.width, _plan->h_levels, _plan->width, h_reverse);
+		if (err == IMAGE_UTIL_ERROR_NONE)
+			err = __filter_create(&_plan->v_filter, _plan->filter, _area.height, 0, _area.height, _plan->v_levels, _plan->height, false);
+	}
+
+	/* the area starts at the halved sample, so the halving is on the same grid as the whole image */
+	if (roi && err == IMAGE_UTIL_ERROR_NONE) {
+		__filter_rebase(&_plan->h_filter, _plan->width, &lo, &hi);
+		_plan->area.x = lo << _plan->h_levels;
+		_plan->area.width = ((hi << _plan->h_levels < src_width) ? hi << _plan->h_levels : src_width) - _plan->area.x;
+		_plan->in_width = hi - lo;
+		__filter_rebase(&_plan->v_filter, _plan->height, &lo, &hi);
+		_plan->area.y = lo << _plan->v_levels;
+		_plan->area.height = ((hi << _plan->v_levels < src_height) ? hi << _plan->v_levels : src_height) - _plan->area.y;
+		_plan->in_height = hi - lo;
+	}
+
+	/* the colorspace is converted on the smaller side of the resizing */
+	_plan->convert_early = ((uint64_t)_plan->in_width * _plan->in_height <= (uint64_t)_plan->width * _plan->height);
+
+	if (err == IMAGE_UTIL_ERROR_NONE) {
+		_plan->resample = _transform_get_resample_kernels();
+		__set_direct_kernel(_plan);
+		err = __buffers_create(_plan, &_plan->buffers);
+	}
+	if (err != IMAGE_UTIL_ERROR_NONE) {
+		__plan_destroy(_plan);
+		return err;
+	}
+
+	*plan = _plan;
+
+	return IMAGE_UTIL_ERROR_NONE;
+}
+
+int _transform_plan_create(image_util_colorspace_e src_colorspace, unsigned int src_width, unsigned int src_height, const transform_area_s *area, image_util_rotation_e rotation,
+	image_util_colorspace_e dst_colorspace, unsigned int dst_width, unsigned int dst_height, const transform_options_s *options, transform_plan_s **plan)
+{
+	return __plan_create(src_colorspace, src_width, src_height, area, false, rotation, dst_colorspace, dst_width, dst_height, options, plan);
+}
+
+int _transform_plan_create_roi(image_util_colorspace_e src_colorspace, unsigned int src_width, unsigned int src_height, const transform_area_s *roi, image_util_rotation_e rotation,
+	image_util_colorspace_e dst_colorspace, unsigned int dst_width, unsigned int dst_height, const transform_options_s *options, transform_plan_s **plan)
+{
+	image_util_retvm_if((roi == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid roi");
+
+	return __plan_create(src_colorspace, src_width, src_height, roi, true, rotation, dst_colorspace, dst_width, dst_height, options, plan);
+}
+
+transform_plan_s *_transform_plan_ref(transform_plan_s *plan)
+{
+	if (plan)
+		g_atomic_int_inc(&plan->ref_count);
+
+	return plan;
+}
+
+void _transform_plan_unref(transform_plan_s *plan)
+{
+	if (plan && g_atomic_int_dec_and_test(&plan->ref_count))
+		__plan_destroy(plan);
+}
+
+/* the flips and the reorders of the 32 bits pixels of the whole image are made in the same buffer */
+static bool __is_in_place(const transform_plan_s *plan, const transform_image_s *src, const transform_image_s *dst)
+{
+	unsigned int plane = 0;
+	bool swizzle = (plan->swizzle_row && !plan->rgb565_kernels && plan->swizzle.in_bpp == plan->swizzle.out_bpp);
+
+	if ((!plan->reverse_kernels && !swizzle) || plan->area.x != 0 || plan->area.y != 0 || plan->area.width != src->width || plan->area.height != src->height)
+		return false;
+
+	for (plane = 0; plane < plan->src_format->num_planes; plane++) {
+		if (src->planes[plane] != dst->planes[plane] || src->strides[plane] != dst->strides[plane])
+			return false;
+	}
+
+	return true;
+}
+
+typedef int (*transform_render_func)(transform_context_s *ctx);
+
+/* the runs at the same time, like the items of a batch, use their own buffers */
+static int __buffers_acquire(transform_plan_s *plan, transform_buffers_s *buffers, bool *shared)
+{
+	*shared = g_atomic_int_compare_and_exchange(&plan->busy, 0, 1);
+	if (*shared) {
+		*buffers = plan->buffers;
+		return IMAGE_UTIL_ERROR_NONE;
+	}
+
+	return __buffers_create(plan, buffers);
+}
+
+static void __buffers_release(transform_plan_s *plan, transform_buffers_s *buffers, bool shared)
+{
+	if (shared)
+		g_atomic_int_set(&plan->busy, 0);
+	else
+		__buffers_destroy(buffers);
+}
+
+/* the bands of a run, which are claimed one by one by the calling thread and the works on the scheduler */
+typedef struct {
+	transform_plan_s *plan;
+	const transform_image_s *src;
+	transform_image_s *dst;
+	transform_check_func check;
+	void *check_data;
+	transform_render_func render;
+	unsigned int total;
+	unsigned int num_bands;
+	gint error;		/* the first error of the bands, the rest are skipped */
+} transform_bands_s;
+
+/* the context of a work on the scheduler with its own buffers, *@local of __run_band points to its first member */
+typedef struct {
+	transform_context_s ctx;
+	transform_buffers_s buffers;
+} transform_band_context_s;
+
+static void __context_init(transform_context_s *ctx, const transform_plan_s *plan, const transform_image_s *src, transform_image_s *dst,
+	const transform_buffers_s *buffers, transform_check_func check, void *check_data)
+{
+	memset(ctx, 0, sizeof(transform_context_s));
+	ctx->src = src;
+	ctx->dst = dst;
+	ctx->area = plan->area;
+	ctx->rotation = plan->rotation;
+	ctx->src_format = plan->src_format;
+	ctx->dst_format = plan->dst_format;
+	ctx->pack = plan->pack;
+	ctx->convert_early = plan->convert_early;
+	ctx->dither = plan->dither;
+	ctx->check = check;
+	ctx->check_data = check_data;
+	ctx->h_levels = plan->h_levels;
+	ctx->v_levels = plan->v_levels;
+	ctx->in_width = plan->in_width;
+	ctx->width = plan->width;
+	ctx->height = plan->height;
+	ctx->h_filter = plan->h_filter;
+	ctx->v_filter = plan->v_filter;
+	ctx->resample = plan->resample;
+	ctx->yuv_to_rgb = plan->yuv_to_rgb;
+	ctx->rgb_to_yuv = plan->rgb_to_yuv;
+	ctx->order = plan->order;
+	ctx->yuv_kernels = plan->yuv_kernels;
+	ctx->swizzle_row = plan->swizzle_row;
+	ctx->swizzle = &plan->swizzle;
+	ctx->rgb565_kernels = plan->rgb565_kernels;
+	ctx->transpose_kernels = plan->transpose_kernels;
+	ctx->reverse_kernels = plan->reverse_kernels;
+	ctx->in_row = buffers->in_row;
+	ctx->halves = buffers->halves;
+	ctx->ring = buffers->ring;
+	ctx->ring_rows = buffers->ring_rows;
+	ctx->rows = buffers->rows;
+	ctx->segments = buffers->segments;
+}
+
+/* the render of the context and the @total of the rows or the tiles which it is split by */
+static transform_render_func __get_render(const transform_context_s *ctx, unsigned int *total)
+{
+	*total = ctx->dst->height;
+
+	if (ctx->yuv_to_rgb)
+		return __render_yuv_to_rgb;
+	if (ctx->rgb_to_yuv)
+		return __render_rgb_to_yuv;
+	if (ctx->yuv_kernels && ctx->dst_format->domain == TRANSFORM_DOMAIN_YUV)
+		return __render_yuv_layout;
+	if (ctx->rgb565_kernels)
+		return __render_rgb565;
+	if (ctx->swizzle_row)
+		return __render_swizzle;
+
+	if (ctx->transpose_kernels) {
+		*total = ctx->area.height;
+		return __render_transpose;
+	}
+
+	if (ctx->reverse_kernels) {
+		/* the pairs of the rows are swapped in place */
+		if (ctx->src->planes[0] == ctx->dst->planes[0] && (ctx->rotation == IMAGE_UTIL_ROTATION_FLIP_VERT || ctx->rotation == IMAGE_UTIL_ROTATION_180))
+			*total = (ctx->dst->height + 1) / 2;
+		return __render_flip;
+	}
+
+	if (ctx->rotation == IMAGE_UTIL_ROTATION_90 || ctx->rotation == IMAGE_UTIL_ROTATION_270) {
+		*total = (ctx->dst->width + TILE_SIZE - 1) / TILE_SIZE;
+		return __render_tiles;
+	}
+
+	return __render_rows;
+}
+
+/* the number of the bands of the @total rows or tiles, 1 if the run is too small to be split */
+static unsigned int __get_num_bands(const transform_plan_s *plan, unsigned int total, unsigned int *num_threads)
+{
+	uint64_t pixels = (uint64_t)plan->area.width * plan->area.height + (uint64_t)plan->dst_width * plan->dst_height;
+	uint64_t num_bands = 0;
+	unsigned int threads = g_get_num_processors();
+
+	if (plan->max_threads > 0 && plan->max_threads < threads)
+		threads = plan->max_threads;
+	if (threads < 2)
+		return 1;
+
+	/* a few bands of each thread for the balance, but not too small ones */
+	num_bands = (uint64_t)threads * BANDS_PER_THREAD;
+	if (num_bands > pixels / BAND_MIN_PIXELS)
+		num_bands = pixels / BAND_MIN_PIXELS;
+	if (num_bands > total / (BAND_ALIGN * 2))
+		num_bands = total / (BAND_ALIGN * 2);
+	if (num_bands < 2)
+		return 1;
+
+	*num_threads = (threads < num_bands) ? threads : (unsigned int)num_bands;
+
+	return (unsigned int)num_bands;
+}
+
+static inline unsigned int __get_band_start(const transform_bands_s *bands, unsigned int band)
+{
+	if (band >= bands->num_bands)
+		return bands->total;
+
+	return (unsigned int)((uint64_t)bands->total * band / bands->num_bands) & ~(BAND_ALIGN - 1U);
+}
+
+/* renders the @band by the context of the thread in *@local, the works on the scheduler make it once they claim a band */
+static int __run_band(void *data, unsigned int band, void **local)
+{
+	transform_bands_s *bands = (transform_bands_s *)data;
+	transform_band_context_s *band_ctx = NULL;
+	transform_context_s *ctx = (transform_context_s *)*local;
+	int err = g_atomic_int_get(&bands->error);
+
+	if (err != IMAGE_UTIL_ERROR_NONE)
+		return err;
+
+	if (ctx == NULL) {
+		band_ctx = (transform_band_context_s *)calloc(1, sizeof(transform_band_context_s));
+		if (band_ctx == NULL || __buffers_create(bands->plan, &band_ctx->buffers) != IMAGE_UTIL_ERROR_NONE) {
+			IMAGE_UTIL_SAFE_FREE(band_ctx);
+			g_atomic_int_compare_and_exchange(&bands->error, IMAGE_UTIL_ERROR_NONE, IMAGE_UTIL_ERROR_OUT_OF_MEMORY);
+			return IMAGE_UTIL_ERROR_OUT_OF_MEMORY;
+		}
+		__context_init(&band_ctx->ctx, bands->plan, bands->src, bands->dst, &band_ctx->buffers, bands->check, bands->check_data);
+		ctx = &band_ctx->ctx;
+		*local = ctx;
+	}
+
+	ctx->first = __get_band_start(bands, band);
+	ctx->last = __get_band_start(bands, band + 1);
+	ctx->total = bands->total;
+	ctx->next_row = 0;
+	err = bands->render(ctx);
+	if (err != IMAGE_UTIL_ERROR_NONE)
+		g_atomic_int_compare_and_exchange(&bands->error, IMAGE_UTIL_ERROR_NONE, err);
+
+	return err;
+}
+
+static void __free_band_context(void *local)
+{
+	transform_band_context_s *band_ctx = (transform_band_context_s *)local;
+
+	__buffers_destroy(&band_ctx->buffers);
+	IMAGE_UTIL_SAFE_FREE(band_ctx);
+}
+
+/* runs the bands on the @num_threads threads with the calling one, which renders by the @ctx */
+static int __run_bands(transform_plan_s *plan, transform_context_s *ctx, transform_render_func render, unsigned int total, unsigned int num_bands, unsigned int num_threads)
+{
+	transform_bands_s bands;
+
+	memset(&bands, 0, sizeof(transform_bands_s));
+	bands.plan = plan;
+	bands.src = ctx->src;
+	bands.dst = ctx->dst;
+	bands.check = ctx->check;
+	bands.check_data = ctx->check_data;
+	bands.render = render;
+	bands.total = total;
+	bands.num_bands = num_bands;
+
+	return _image_util_scheduler_run_parallel(plan->priority, num_bands, num_threads, __run_band, __free_band_context, &bands, ctx);
+}
+
+int _transform_plan_run(transform_plan_s *plan, const transform_image_s *src, transform_image_s *dst, transform_check_func check, void *check_data)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transform_context_s ctx;
+	transform_buffers_s buffers;
+	transform_render_func render = NULL;
+	unsigned int total = 0, num_bands = 0, num_threads = 1;
+	bool shared = false;
+
+	image_util_retvm_if((plan == NULL || src == NULL || dst == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid parameter");
+	image_util_retvm_if((src->colorspace != plan->src_colorspace || src->width != plan->src_width || src->height != plan->src_height),
+		IMAGE_UTIL_ERROR_INVALID_PARAMETER, "The source doesn't match the plan");
+	image_util_retvm_if((dst->colorspace != plan->dst_colorspace || dst->width != plan->dst_width || dst->height != plan->dst_height),
+		IMAGE_UTIL_ERROR_INVALID_PARAMETER, "The destination doesn't match the plan");
+	image_util_retvm_if((src->planes[0] == dst->planes[0] && !__is_in_place(plan, src, dst)),
+		IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT, "Only the flips and the 32 bits reorders of the whole image are made in place");
+
+	err = __buffers_acquire(plan, &buffers, &shared);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "__buffers_acquire failed (%d)", err);
+
+	__context_init(&ctx, plan, src, dst, &buffers, check, check_data);
+	render = __get_render(&ctx, &total);
+
+	/* the large runs are split into the bands which run on the scheduler too */
+	num_bands = __get_num_bands(plan, total, &num_threads);
+	if (num_bands > 1) {
+		err = __run_bands(plan, &ctx, render, total, num_bands, num_threads);
+	} else {
+		ctx.first = 0;
+		ctx.last = total;
+		ctx.total = total;
+		err = render(&ctx);
+	}
+
+	__buffers_release(plan, &buffers, shared);
+
+	return err;
+}
+
+int _transform_plan_run_strips(transform_plan_s *plan, transform_read_func read, transform_write_func write, void *user_data, transform_check_func check, void *check_data)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transform_context_s ctx;
+	transform_buffers_s buffers;
+	transform_strips_s strips;
+	bool shared = false;
+
+	image_util_retvm_if((plan == NULL || read == NULL || write == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid parameter");
+	/* the other rotations need the last source row for the first destination row */
+	image_util_retvm_if((plan->rotation != IMAGE_UTIL_ROTATION_NONE && plan->rotation != IMAGE_UTIL_ROTATION_FLIP_HORZ),
+		IMAGE_UTIL_ERROR_NOT_SUPPORTED_FORMAT, "Not supported rotation in the strips (%d)", plan->rotation);
+
+	memset(&strips, 0, sizeof(transform_strips_s));
+	strips.read = read;
+	strips.write = write;
+	strips.user_data = user_data;
+	strips.src_colorspace = plan->src_colorspace;
+	strips.src_width = plan->src_width;
+	strips.src_y = plan->area.y & ~1U;
+	strips.src_size = _transform_get_buffer_size(plan->src_colorspace, plan->src_width, STRIP_ROWS);
+	strips.src_buffer = (unsigned char *)calloc(1, strips.src_size);
+	strips.dst_colorspace = plan->dst_colorspace;
+	strips.dst_width = plan->dst_width;
+	strips.dst_size = _transform_get_buffer_size(plan->dst_colorspace, plan->dst_width, STRIP_ROWS);
+	strips.dst_buffer = (unsigned char *)calloc(1, strips.dst_size);
+	if (strips.src_buffer && strips.dst_buffer)
+		err = __buffers_acquire(plan, &buffers, &shared);
+	else
+		err = IMAGE_UTIL_ERROR_OUT_OF_MEMORY;
+
+	if (err == IMAGE_UTIL_ERROR_NONE) {
+		/* the direct kernels of the plan need the whole source, so the rows are always resampled */
+		__context_init(&ctx, plan, NULL, &strips.dst, &buffers, check, check_data);
+		ctx.strips = &strips;
+		err = __render_strips(&ctx);
+		__buffers_release(plan, &buffers, shared);
+	} else {
+		image_util_error("Memory allocation failed");
+	}
+
+	IMAGE_UTIL_SAFE_FREE(strips.src_buffer);
+	IMAGE_UTIL_SAFE_FREE(strips.dst_buffer);
+
+	return err;
+}
+
+int _transform_run(const transform_image_s *src, const transform_area_s *area, image_util_rotation_e rotation, const transform_options_s *options, transform_image_s *dst, transform_check_func check, void *check_data)
+{
+	int err = IMAGE_UTIL_ERROR_NONE;
+	transform_plan_s *plan = NULL;
+
+	image_util_retvm_if((src == NULL || dst == NULL), IMAGE_UTIL_ERROR_INVALID_PARAMETER, "Invalid image");
+
+	err = _transform_plan_create(src->colorspace, src->width, src->height, area, rotation, dst->colorspace, dst->width, dst->height, options, &plan);
+	image_util_retvm_if((err != IMAGE_UTIL_ERROR_NONE), err, "_transform_plan_create failed (%d)", err);
+
+	err = _transform_plan_run(plan, src, dst, check, check_data);
+
+	_transform_plan_unref(plan);
+
+	return err;
+}
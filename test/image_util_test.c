@@ -26,6 +26,8 @@
 #define MAX_STRING_LEN 128
 #define IMAGE_FORMAT_LABEL_BUFFER_SIZE 4
 #define IMAGE_TEST_MAX_REPEAT_COUNT 100
+#define IMAGE_TEST_BENCHMARK_FRAMES 240
+#define IMAGE_TEST_STREAM_SIZE 4
 
 #define IMAGE_UTIL_SAFE_FREE(src)      { if (src) {free(src); src = NULL; } }
 
@@ -401,6 +403,149 @@ static void _loop_test(const int count)
 	}
 }
 
+static gint64 g_submitted[IMAGE_TEST_BENCHMARK_FRAMES];
+static gint64 g_completed[IMAGE_TEST_BENCHMARK_FRAMES];
+static gint g_num_completed = 0;
+
+static void _benchmark_report(const char *name, unsigned int fps, unsigned int dropped)
+{
+	gint64 interval = G_USEC_PER_SEC / fps;
+	gint64 latency = 0, total = 0, max = 0;
+	unsigned int i = 0, done = 0, late = 0;
+
+	for (i = 0; i < IMAGE_TEST_BENCHMARK_FRAMES; i++) {
+		if (g_completed[i] == 0)
+			continue;
+		latency = g_completed[i] - g_submitted[i];
+		total += latency;
+		if (latency > max)
+			max = latency;
+		if (latency > interval)
+			late++;
+		done++;
+	}
+
+	g_printf("[%s] %3u fps: done %u, dropped %u, late %u, latency avg %" G_GINT64_FORMAT " us, max %" G_GINT64_FORMAT " us\n",
+		name, fps, done, dropped, late, done ? total / done : 0, max);
+}
+
+/* waits until the frame @index is due at @fps */
+static void _benchmark_wait_frame(gint64 start, unsigned int fps, unsigned int index)
+{
+	gint64 due = start + (gint64)index * G_USEC_PER_SEC / fps;
+	gint64 now = g_get_monotonic_time();
+
+	if (due > now)
+		g_usleep((gulong)(due - now));
+}
+
+static bool _benchmark_completed_cb(media_packet_h *packet, image_util_error_e error, void *user_data)
+{
+	unsigned int index = GPOINTER_TO_UINT(user_data);
+
+	if (error == IMAGE_UTIL_ERROR_NONE) {
+		g_completed[index] = g_get_monotonic_time();
+		media_packet_destroy(*packet);
+	}
+	g_atomic_int_inc(&g_num_completed);
+
+	return TRUE;
+}
+
+static void _benchmark_run(unsigned int fps)
+{
+	gint64 start = g_get_monotonic_time();
+	unsigned int i = 0, submitted = 0, dropped = 0;
+
+	memset(g_submitted, 0, sizeof(g_submitted));
+	memset(g_completed, 0, sizeof(g_completed));
+	g_atomic_int_set(&g_num_completed, 0);
+
+	for (i = 0; i < IMAGE_TEST_BENCHMARK_FRAMES; i++) {
+		_benchmark_wait_frame(start, fps, i);
+		g_submitted[i] = g_get_monotonic_time();
+		if (image_util_transform_run(g_handle, g_src, (image_util_transform_completed_cb)_benchmark_completed_cb, GUINT_TO_POINTER(i)) == IMAGE_UTIL_ERROR_NONE)
+			submitted++;
+		else
+			dropped++;
+	}
+
+	while ((unsigned int)g_atomic_int_get(&g_num_completed) < submitted)
+		g_usleep(1000);
+
+	_benchmark_report("run", fps, dropped);
+}
+
+static void _benchmark_pop(transformation_stream_h stream, unsigned int *index)
+{
+	media_packet_h src = NULL;
+	media_packet_h dst = NULL;
+	int ret = 0;
+
+	while ((ret = image_util_transform_stream_pop(stream, &src, &dst)) != IMAGE_UTIL_ERROR_NO_DATA) {
+		/* the results are in the order of pushing */
+		while (g_submitted[*index] == 0)
+			(*index)++;
+		if (ret == IMAGE_UTIL_ERROR_NONE) {
+			g_completed[*index] = g_get_monotonic_time();
+			media_packet_destroy(dst);
+		}
+		(*index)++;
+		g_num_completed++;
+	}
+}
+
+static void _benchmark_stream(unsigned int fps)
+{
+	transformation_stream_h stream = NULL;
+	gint64 start = 0;
+	unsigned int i = 0, submitted = 0, dropped = 0, index = 0;
+	int ret = 0;
+
+	ret = image_util_transform_stream_create(g_handle, IMAGE_TEST_STREAM_SIZE, &stream);
+	if (ret != IMAGE_UTIL_ERROR_NONE) {
+		g_printf("[%d]Error image_util_transform_stream_create [%d]\n", __LINE__, ret);
+		return;
+	}
+
+	memset(g_submitted, 0, sizeof(g_submitted));
+	memset(g_completed, 0, sizeof(g_completed));
+	g_num_completed = 0;
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < IMAGE_TEST_BENCHMARK_FRAMES; i++) {
+		_benchmark_wait_frame(start, fps, i);
+		_benchmark_pop(stream, &index);
+		g_submitted[i] = g_get_monotonic_time();
+		if (image_util_transform_stream_push(stream, g_src) == IMAGE_UTIL_ERROR_NONE) {
+			submitted++;
+		} else {
+			g_submitted[i] = 0;
+			dropped++;
+		}
+	}
+
+	while ((unsigned int)g_num_completed < submitted) {
+		g_usleep(1000);
+		_benchmark_pop(stream, &index);
+	}
+
+	image_util_transform_stream_destroy(stream);
+
+	_benchmark_report("stream", fps, dropped);
+}
+
+static void _benchmark(void)
+{
+	unsigned int fps[] = { 30, 60, 120 };
+	unsigned int i = 0;
+
+	for (i = 0; i < sizeof(fps) / sizeof(fps[0]); i++) {
+		_benchmark_run(fps[i]);
+		_benchmark_stream(fps[i]);
+	}
+}
+
 void quit(void)
 {
 	if (g_loop)
@@ -459,6 +604,7 @@ static void display_menu(void)
 	g_print("7. run \n");
 	g_print("8. run repeatly \n");
 	g_print("9. destroy handle \n");
+	g_print("a. benchmark run and stream \n");
 	g_print("0. quit \n");
 	g_print("----------------------------------------------------\n");
 	g_print("====================================================\n");
@@ -556,6 +702,8 @@ static void interpret_cmd(char *cmd)
 				_loop_test(IMAGE_TEST_MAX_REPEAT_COUNT);
 			} else if (!strncmp(cmd, "9", len)) {
 				_destroy();
+			} else if (!strncmp(cmd, "a", len)) {
+				_benchmark();
 			} else if (!strncmp(cmd, "0", len)) {
 				quit();
 			}